@@ -0,0 +1,170 @@
+/* Benchmark of the scaling of the work stealing thread pool
+(C) 2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2020
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+// Build with: g++ -std=c++20 -fcoroutines -O3 -I../include channel_throughput.cpp -lpthread
+// Prints a CSV of items per second passed from producer threads to consumer threads, through
+// a std::deque behind a mutex and condition variable, and through awaitables::channel.
+
+#include "timing.h"
+#include "../include/outcome/coroutine_support.hpp"
+#include "../include/outcome/channel.hpp"
+#include "../include/outcome.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define ITEMS 2000000
+#define CAPACITY 1024
+
+namespace awaitables = OUTCOME_V2_NAMESPACE::awaitables;
+template <class T> using result = OUTCOME_V2_NAMESPACE::result<T>;
+
+class deque_queue
+{
+  std::mutex _lock;
+  std::condition_variable _not_empty, _not_full;
+  std::deque<result<int>> _items;
+  bool _closed{false};
+
+public:
+  void send(result<int> v)
+  {
+    std::unique_lock<std::mutex> g(_lock);
+    _not_full.wait(g, [&] { return _items.size() < CAPACITY; });
+    _items.push_back(std::move(v));
+    _not_empty.notify_one();
+  }
+  result<int> receive()
+  {
+    std::unique_lock<std::mutex> g(_lock);
+    _not_empty.wait(g, [&] { return !_items.empty() || _closed; });
+    if(_items.empty())
+    {
+      return std::errc::broken_pipe;
+    }
+    auto ret = std::move(_items.front());
+    _items.pop_front();
+    _not_full.notify_one();
+    return ret;
+  }
+  void close()
+  {
+    std::lock_guard<std::mutex> g(_lock);
+    _closed = true;
+    _not_empty.notify_all();
+  }
+};
+
+using channel = awaitables::channel<result<int>>;
+
+static awaitables::atomic_eager<result<void>> produce(channel &ch, int items)
+{
+  for(int n = 0; n < items; n++)
+  {
+    OUTCOME_CO_TRY(co_await ch.send(n));
+  }
+  co_return OUTCOME_V2_NAMESPACE::success();
+}
+static awaitables::atomic_eager<result<long>> consume(channel &ch)
+{
+  long ret = 0;
+  for(;;)
+  {
+    auto r = co_await ch.receive();
+    if(!r)
+    {
+      co_return ret;
+    }
+    ret += r.value();
+  }
+}
+
+template <class F> static double run(unsigned threads, F &&f)
+{
+  auto start = GetUsCount();
+  f(threads);
+  auto end = GetUsCount();
+  return ITEMS / ((end - start) / 1000000000000.0);
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned maxthreads = (argc > 1) ? (unsigned) atoi(argv[1]) : 4;
+  printf("producers and consumers,deque items per sec,channel items per sec\n");
+  for(unsigned threads = 1; threads <= maxthreads; threads++)
+  {
+    double deque_persec = run(threads, [](unsigned threads) {
+      deque_queue q;
+      std::vector<std::thread> producers, consumers;
+      for(unsigned n = 0; n < threads; n++)
+      {
+        consumers.emplace_back([&] {
+          while(q.receive())
+          {
+          }
+        });
+        producers.emplace_back([&] {
+          for(int i = 0; i < ITEMS / (int) threads; i++)
+          {
+            q.send(i);
+          }
+        });
+      }
+      for(auto &t : producers)
+      {
+        t.join();
+      }
+      q.close();
+      for(auto &t : consumers)
+      {
+        t.join();
+      }
+    });
+    double channel_persec = run(threads, [](unsigned threads) {
+      channel ch(CAPACITY);
+      std::vector<std::thread> producers, consumers;
+      for(unsigned n = 0; n < threads; n++)
+      {
+        consumers.emplace_back([&] { (void) awaitables::sync_wait(consume(ch)); });
+        producers.emplace_back([&] { (void) awaitables::sync_wait(produce(ch, ITEMS / (int) threads)); });
+      }
+      for(auto &t : producers)
+      {
+        t.join();
+      }
+      ch.close(make_error_code(std::errc::broken_pipe));
+      for(auto &t : consumers)
+      {
+        t.join();
+      }
+    });
+    printf("%u,%f,%f\n", threads, deque_persec, channel_persec);
+  }
+  return 0;
+}
@@ -0,0 +1,110 @@
+/* Benchmark of the scaling of the work stealing thread pool
+(C) 2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2020
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+// Build with: g++ -std=c++20 -fcoroutines -O3 -I../include thread_pool_scaling.cpp -lpthread
+// Prints a CSV of tasks per second and speedup for 1 to N worker threads.
+
+#include "timing.h"
+#include "../include/outcome/coroutine_support.hpp"
+#include "../include/outcome/thread_pool.hpp"
+#include "../include/outcome.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#define TASKS 100000
+#define WORK 2000  // iterations of CPU bound work per task
+
+namespace awaitables = OUTCOME_V2_NAMESPACE::awaitables;
+template <class T> using result = OUTCOME_V2_NAMESPACE::result<T>;
+
+static awaitables::atomic_lazy<result<unsigned>> work(unsigned seed)
+{
+  unsigned x = seed | 1;
+  for(int n = 0; n < WORK; n++)
+  {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+  }
+  if(x == 0)
+  {
+    co_return std::errc::result_out_of_range;
+  }
+  co_return x;
+}
+
+static awaitables::atomic_lazy<result<unsigned>> fan_out(awaitables::thread_pool &pool)
+{
+  std::vector<decltype(pool.spawn(work(0)))> tasks;
+  tasks.reserve(TASKS);
+  for(unsigned n = 0; n < TASKS; n++)
+  {
+    tasks.push_back(pool.spawn(work(n)));
+  }
+  unsigned ret = 0;
+  for(auto &t : tasks)
+  {
+    OUTCOME_CO_TRY(auto v, co_await t);
+    ret += v;
+  }
+  co_return ret;
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned maxthreads = (argc > 1) ? (unsigned) atoi(argv[1]) : std::thread::hardware_concurrency();
+  if(maxthreads == 0)
+  {
+    maxthreads = 1;
+  }
+  printf("threads,tasks per sec,speedup\n");
+  double base = 0;
+  for(unsigned threads = 1; threads <= maxthreads; threads++)
+  {
+    awaitables::thread_pool pool(threads);
+    auto start = GetUsCount();
+    auto s = pool.spawn(fan_out(pool));
+    while(!s.await_ready())
+    {
+      std::this_thread::yield();
+    }
+    auto r = s.await_resume();
+    auto end = GetUsCount();
+    if(!r)
+    {
+      fprintf(stderr, "FATAL: %s\n", r.error().message().c_str());
+      return 1;
+    }
+    double persec = TASKS / ((end - start) / 1000000000000.0);
+    if(threads == 1)
+    {
+      base = persec;
+    }
+    printf("%u,%f,%f\n", threads, persec, persec / base);
+  }
+  return 0;
+}
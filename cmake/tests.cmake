@@ -2,13 +2,30 @@
 set(outcome_TESTS
   "test/expected-pass.cpp"
   "test/single-header-test.cpp"
+  "test/tests/arena-exception.cpp"
   "test/tests/comparison.cpp"
+  "test/tests/compact-status.cpp"
   "test/tests/constexpr.cpp"
+  "test/tests/cold-error.cpp"
   "test/tests/containers.cpp"
   "test/tests/core-outcome.cpp"
   "test/tests/core-result.cpp"
+  "test/tests/coroutine-await-result.cpp"
+  "test/tests/coroutine-cancellation.cpp"
+  "test/tests/coroutine-channel.cpp"
+  "test/tests/coroutine-deadline.cpp"
+  "test/tests/coroutine-frame-pool.cpp"
+  "test/tests/coroutine-generator.cpp"
+  "test/tests/coroutine-maybe-ready.cpp"
+  "test/tests/coroutine-reactor.cpp"
+  "test/tests/coroutine-shared-lazy.cpp"
   "test/tests/coroutine-support.cpp"
+  "test/tests/coroutine-sync-wait.cpp"
+  "test/tests/coroutine-thread-pool.cpp"
+  "test/tests/coroutine-when-all.cpp"
+  "test/tests/coroutine-when-any.cpp"
   "test/tests/default-construction.cpp"
+  "test/tests/error-from-exception.cpp"
   "test/tests/experimental-core-outcome-status.cpp"
   "test/tests/experimental-core-result-status.cpp"
   "test/tests/experimental-p0709a.cpp"
@@ -34,11 +51,19 @@ set(outcome_TESTS
   "test/tests/issue0220.cpp"
   "test/tests/issue0244.cpp"
   "test/tests/issue0247.cpp"
+  "test/tests/move-bitcopying-assignment.cpp"
+  "test/tests/niche-storage.cpp"
   "test/tests/noexcept-propagation.cpp"
+  "test/tests/packed-storage.cpp"
   "test/tests/propagate.cpp"
+  "test/tests/result-status-scan.cpp"
+  "test/tests/result-vector.cpp"
   "test/tests/serialisation.cpp"
   "test/tests/success-failure.cpp"
   "test/tests/swap.cpp"
+  "test/tests/trivially-relocatable.cpp"
+  "test/tests/try-all.cpp"
+  "test/tests/try-forward-failure.cpp"
   "test/tests/udts.cpp"
   "test/tests/value-or-error.cpp"
 )
@@ -0,0 +1,264 @@
+/* Arena allocated exceptions for outcome
+(C) 2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2020
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_ARENA_EXCEPTION_HPP
+#define OUTCOME_ARENA_EXCEPTION_HPP
+
+#include "outcome.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>  // for std::align
+#include <new>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+class exception_arena;
+class arena_exception_ptr;
+
+namespace detail
+{
+  // The header of each exception captured into an exception_arena
+  struct arena_exception_record
+  {
+    arena_exception_record *next;
+    void (*destroy)(arena_exception_record *) noexcept;
+    std::exception_ptr (*to_exception_ptr)(const arena_exception_record *);
+  };
+  template <class E> struct arena_exception_record_impl : arena_exception_record
+  {
+    E value;
+
+    template <class... Args>
+    explicit arena_exception_record_impl(Args &&... args)
+        : arena_exception_record{nullptr, &_destroy, &_to_exception_ptr}
+        , value(static_cast<Args &&>(args)...)
+    {
+    }
+    static void _destroy(arena_exception_record *r) noexcept { static_cast<arena_exception_record_impl *>(r)->~arena_exception_record_impl(); }
+    static std::exception_ptr _to_exception_ptr(const arena_exception_record *r) { return std::make_exception_ptr(static_cast<const arena_exception_record_impl *>(r)->value); }
+  };
+  // A std::exception_ptr captured into an arena converts back to itself
+  template <> inline std::exception_ptr arena_exception_record_impl<std::exception_ptr>::_to_exception_ptr(const arena_exception_record *r)
+  {
+    return static_cast<const arena_exception_record_impl *>(r)->value;
+  }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  exception_arena. Potential doc page: `exception_arena`
+*/
+class exception_arena
+{
+  struct _block
+  {
+    _block *next;
+    size_t size;
+  };
+
+  char *_cur{nullptr}, *_end{nullptr};
+  char *_buffer{nullptr};
+  size_t _buffer_size{0};
+  size_t _block_size{4096};
+  size_t _heap_bytes{0};
+  _block *_blocks{nullptr};
+  detail::arena_exception_record *_records{nullptr};
+  size_t _count{0};
+
+  static exception_arena *&_current() noexcept
+  {
+    static thread_local exception_arena *v;
+    return v;
+  }
+
+  void *_allocate(size_t bytes, size_t align)
+  {
+    void *p = _cur;
+    size_t space = static_cast<size_t>(_end - _cur);
+    if(_cur == nullptr || std::align(align, bytes, p, space) == nullptr)
+    {
+      // Chain a new block from the heap, big enough for this allocation
+      const size_t size = std::max(_block_size, sizeof(_block) + align + bytes);
+      auto *b = static_cast<_block *>(::operator new(size));
+      b->next = _blocks;
+      b->size = size;
+      _blocks = b;
+      _heap_bytes += size;
+      _cur = reinterpret_cast<char *>(b + 1);
+      _end = reinterpret_cast<char *>(b) + size;
+      p = _cur;
+      space = static_cast<size_t>(_end - _cur);
+      std::align(align, bytes, p, space);
+    }
+    _cur = static_cast<char *>(p) + bytes;
+    return p;
+  }
+
+public:
+  //! Constructs an arena which allocates blocks of `block_size` bytes from the heap.
+  explicit exception_arena(size_t block_size = 4096) noexcept
+      : _block_size(block_size)
+  {
+  }
+  //! Constructs an arena which allocates from `buffer` first, then from blocks of `block_size` bytes from the heap.
+  exception_arena(void *buffer, size_t bytes, size_t block_size = 4096) noexcept
+      : _cur(static_cast<char *>(buffer))
+      , _end(static_cast<char *>(buffer) + bytes)
+      , _buffer(static_cast<char *>(buffer))
+      , _buffer_size(bytes)
+      , _block_size(block_size)
+  {
+  }
+  exception_arena(const exception_arena &) = delete;
+  exception_arena(exception_arena &&) = delete;
+  exception_arena &operator=(const exception_arena &) = delete;
+  exception_arena &operator=(exception_arena &&) = delete;
+  ~exception_arena()
+  {
+    release();
+    if(_current() == this)
+    {
+      _current() = nullptr;
+    }
+  }
+
+  //! The arena used by this thread when none is specified. Unless set using `scope`, a thread local arena.
+  static exception_arena &current() noexcept
+  {
+    exception_arena *ret = _current();
+    if(ret == nullptr)
+    {
+      static thread_local exception_arena v;
+      ret = &v;
+    }
+    return *ret;
+  }
+
+  //! Makes an arena the current arena of this thread for the lifetime of the scope.
+  class scope
+  {
+    exception_arena *_prev;
+
+  public:
+    explicit scope(exception_arena &a) noexcept
+        : _prev(_current())
+    {
+      _current() = &a;
+    }
+    scope(const scope &) = delete;
+    scope &operator=(const scope &) = delete;
+    ~scope() { _current() = _prev; }
+  };
+
+  //! The number of exceptions captured since the last release.
+  size_t size() const noexcept { return _count; }
+  //! The bytes of heap blocks chained since the last release.
+  size_t heap_bytes() const noexcept { return _heap_bytes; }
+
+  //! Destroys every exception captured into the arena, and frees the heap blocks. All `arena_exception_ptr` into this arena become dangling.
+  void release() noexcept
+  {
+    while(_records != nullptr)
+    {
+      auto *r = _records;
+      _records = r->next;
+      r->destroy(r);
+    }
+    while(_blocks != nullptr)
+    {
+      _block *b = _blocks;
+      _blocks = b->next;
+      ::operator delete(b);
+    }
+    _cur = _buffer;
+    _end = _buffer + _buffer_size;
+    _heap_bytes = 0;
+    _count = 0;
+  }
+
+  //! Constructs an exception of type `E` from `args` within the arena.
+  template <class E, class... Args> inline arena_exception_ptr emplace(Args &&... args);
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  arena_exception_ptr. Potential doc page: `arena_exception_ptr`
+*/
+class arena_exception_ptr
+{
+  friend class exception_arena;
+
+  const detail::arena_exception_record *_r{nullptr};
+
+  explicit constexpr arena_exception_ptr(const detail::arena_exception_record *r) noexcept
+      : _r(r)
+  {
+  }
+
+public:
+  //! Default constructor, refers to no exception.
+  arena_exception_ptr() = default;
+  //! Refers to no exception.
+  constexpr arena_exception_ptr(std::nullptr_t /*unused*/) noexcept {}  // NOLINT
+  //! Captures `e` into the current arena of this thread.
+  arena_exception_ptr(std::exception_ptr e)  // NOLINT
+      : _r((e != nullptr) ? exception_arena::current().emplace<std::exception_ptr>(static_cast<std::exception_ptr &&>(e))._r : nullptr)
+  {
+  }
+
+  //! True if this refers to an exception.
+  constexpr explicit operator bool() const noexcept { return _r != nullptr; }
+  //! Returns a `std::exception_ptr` to a copy of the exception, or to the captured `std::exception_ptr`.
+  std::exception_ptr to_exception_ptr() const { return (_r != nullptr) ? _r->to_exception_ptr(_r) : std::exception_ptr(); }
+  //! Implicit conversion to `std::exception_ptr`, same as `to_exception_ptr()`.
+  operator std::exception_ptr() const { return to_exception_ptr(); }  // NOLINT
+
+  constexpr bool operator==(const arena_exception_ptr &o) const noexcept { return _r == o._r; }
+  constexpr bool operator!=(const arena_exception_ptr &o) const noexcept { return _r != o._r; }
+
+  //! Makes `arena_exception_ptr` an exception pointer type, via `to_exception_ptr()`.
+  friend std::exception_ptr make_exception_ptr(const arena_exception_ptr &e) { return e.to_exception_ptr(); }
+};
+
+template <class E, class... Args> inline arena_exception_ptr exception_arena::emplace(Args &&... args)
+{
+  using record_type = detail::arena_exception_record_impl<std::decay_t<E>>;
+  void *p = _allocate(sizeof(record_type), alignof(record_type));
+  auto *r = new(p) record_type(static_cast<Args &&>(args)...);
+  r->next = _records;
+  _records = r;
+  ++_count;
+  return arena_exception_ptr(r);
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class E> inline arena_exception_ptr make_arena_exception(E &&e, exception_arena &arena = exception_arena::current())
+{
+  return arena.emplace<std::decay_t<E>>(static_cast<E &&>(e));
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
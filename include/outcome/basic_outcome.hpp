@@ -241,6 +241,8 @@ class OUTCOME_NODISCARD basic_outcome
 {
   static_assert(trait::type_can_be_used_in_basic_result<P>, "The exception_type cannot be used");
   static_assert(std::is_void<P>::value || std::is_default_constructible<P>::value, "exception_type must be void or default constructible");
+  static_assert(!detail::is_niche_usable<S, R>::value && !detail::is_niche_usable<R, S>::value,
+                "basic_outcome needs to track an exception, so value_type and error_type cannot use trait::niche storage");
   using base = detail::select_basic_outcome_failure_observers<
   detail::basic_outcome_exception_observers<detail::basic_result_final<R, S, NoValuePolicy>, R, S, P, NoValuePolicy>, R, S, P, NoValuePolicy>;
   friend struct policy::base;
@@ -1116,6 +1118,18 @@ template <class R, class S, class P, class N> inline void swap(basic_outcome<R,
   a.swap(b);
 }
 
+namespace trait
+{
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class S, class P, class N> struct is_trivially_relocatable<basic_outcome<R, S, P, N>>
+  {
+    static constexpr bool value = is_trivially_relocatable<detail::devoid<R>>::value && is_trivially_relocatable<detail::devoid<S>>::value &&
+                                  is_trivially_relocatable<detail::devoid<P>>::value;
+  };
+}  // namespace trait
+
 namespace hooks
 {
   /*! AWAITING HUGO JSON CONVERSION TOOL
@@ -213,7 +213,7 @@ SIGNATURE NOT RECOGNISED
 */
   template <class R, class S, class NoValuePolicy> constexpr inline uint16_t spare_storage(const detail::basic_result_storage<R, S, NoValuePolicy> *r) noexcept
   {
-    return r->_state._status.spare_storage_value;
+    return detail::_spare_storage_value(r->_state._status);
   }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
@@ -221,7 +221,7 @@ SIGNATURE NOT RECOGNISED
   template <class R, class S, class NoValuePolicy>
   constexpr inline void set_spare_storage(detail::basic_result_storage<R, S, NoValuePolicy> *r, uint16_t v) noexcept
   {
-    r->_state._status.spare_storage_value = v;
+    detail::_set_spare_storage_value(r->_state._status, v);
   }
 }  // namespace hooks
 
@@ -707,6 +707,25 @@ SIGNATURE NOT RECOGNISED
     return failure(static_cast<basic_result &&>(*this).assume_error(), hooks::spare_storage(this));
   }
 
+  // Used by `OUTCOME_TRY` to construct the caller's result or outcome directly from our error, without going via `as_failure()`
+  OUTCOME_TEMPLATE(class T, class E = error_type)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::is_constructible<T, in_place_type_t<typename T::error_type>, const E &>))
+  constexpr T _forward_failure() const &
+  {
+    T ret(in_place_type<typename T::error_type>, this->assume_error());
+    hooks::set_spare_storage(&ret, hooks::spare_storage(this));
+    return ret;
+  }
+  OUTCOME_TEMPLATE(class T, class E = error_type)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::is_constructible<T, in_place_type_t<typename T::error_type>, E &&>))
+  constexpr T _forward_failure() &&
+  {
+    this->_state._status.set_have_moved_from(true);
+    T ret(in_place_type<typename T::error_type>, static_cast<basic_result &&>(*this).assume_error());
+    hooks::set_spare_storage(&ret, hooks::spare_storage(this));
+    return ret;
+  }
+
 #ifdef __APPLE__
   failure_type<error_type> _xcode_workaround_as_failure() &&;
 #endif
@@ -720,6 +739,17 @@ template <class R, class S, class P> inline void swap(basic_result<R, S, P> &a,
   a.swap(b);
 }
 
+namespace trait
+{
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class S, class P> struct is_trivially_relocatable<basic_result<R, S, P>>
+  {
+    static constexpr bool value = is_trivially_relocatable<detail::devoid<R>>::value && is_trivially_relocatable<detail::devoid<S>>::value;
+  };
+}  // namespace trait
+
 #if !defined(NDEBUG)
 // Check is trivial in all ways except default constructibility
 // static_assert(std::is_trivial<basic_result<int, long, policy::all_narrow>>::value, "result<int> is not trivial!");
@@ -0,0 +1,493 @@
+/* A bounded channel of results for Outcome's awaitables
+(C) 2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2020
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_CHANNEL_HPP
+#define OUTCOME_CHANNEL_HPP
+
+#include "detail/coroutine_awaitables.hpp"
+
+#if defined(OUTCOME_FOUND_COROUTINE_HEADER)
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+namespace awaitables
+{
+  namespace detail
+  {
+    /* Dmitry Vyukov's bounded multi-producer multi-consumer queue. Each cell carries a
+    sequence number saying whether it is ready to be written or read in the current lap
+    of the ring, so producers and consumers only contend on their own position.
+
+    The sequence numbers are stored and loaded sequentially consistent, so a producer or
+    consumer which registers itself as waiting before retrying cannot miss the wake up
+    from the operation which made room or an item for it.
+    */
+    template <class T> class bounded_ring
+    {
+      struct cell
+      {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T *get() noexcept { return reinterpret_cast<T *>(storage); }
+      };
+
+      const size_t _mask;
+      std::unique_ptr<cell[]> _cells;
+      alignas(64) std::atomic<size_t> _enqueue_pos{0};
+      alignas(64) std::atomic<size_t> _dequeue_pos{0};
+
+      // A ring of one cell cannot tell a full cell from an empty one of the next lap
+      static size_t _round_up(size_t v) noexcept
+      {
+        size_t ret = 2;
+        while(ret < v)
+        {
+          ret <<= 1;
+        }
+        return ret;
+      }
+
+    public:
+      explicit bounded_ring(size_t capacity)
+          : _mask(_round_up(capacity) - 1)
+          , _cells(new cell[_mask + 1])
+      {
+        for(size_t n = 0; n <= _mask; n++)
+        {
+          _cells[n].sequence.store(n, std::memory_order_relaxed);
+        }
+      }
+      bounded_ring(const bounded_ring &) = delete;
+      bounded_ring &operator=(const bounded_ring &) = delete;
+      ~bounded_ring()
+      {
+        size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+        for(;; ++pos)
+        {
+          cell &c = _cells[pos & _mask];
+          if(c.sequence.load(std::memory_order_relaxed) != pos + 1)
+          {
+            break;
+          }
+          c.get()->~T();
+        }
+      }
+
+      size_t capacity() const noexcept { return _mask + 1; }
+
+      // Moves from `v` only if there was room for it
+      bool try_push(T &v) noexcept
+      {
+        size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+        for(;;)
+        {
+          cell &c = _cells[pos & _mask];
+          const size_t seq = c.sequence.load(std::memory_order_seq_cst);
+          const auto dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+          if(dif == 0)
+          {
+            if(_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+              new(c.get()) T(static_cast<T &&>(v));
+              c.sequence.store(pos + 1, std::memory_order_seq_cst);
+              return true;
+            }
+          }
+          else if(dif < 0)
+          {
+            return false;
+          }
+          else
+          {
+            pos = _enqueue_pos.load(std::memory_order_relaxed);
+          }
+        }
+      }
+      // Move constructs the oldest item into `dest`, if there was one
+      bool try_pop(void *dest) noexcept
+      {
+        size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+        for(;;)
+        {
+          cell &c = _cells[pos & _mask];
+          const size_t seq = c.sequence.load(std::memory_order_seq_cst);
+          const auto dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+          if(dif == 0)
+          {
+            if(_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+              new(dest) T(static_cast<T &&>(*c.get()));
+              c.get()->~T();
+              c.sequence.store(pos + _mask + 1, std::memory_order_seq_cst);
+              return true;
+            }
+          }
+          else if(dif < 0)
+          {
+            return false;
+          }
+          else
+          {
+            pos = _dequeue_pos.load(std::memory_order_relaxed);
+          }
+        }
+      }
+    };
+
+    // An intrusive first in first out list of suspended coroutines, protected by the channel's lock
+    struct channel_waiter
+    {
+      channel_waiter *next{nullptr};
+      coroutine_handle<> handle;
+    };
+    template <class Waiter> struct channel_waiters
+    {
+      channel_waiter *head{nullptr}, *tail{nullptr};
+      // Raised before a waiter retries under the lock, so the lock is only taken when someone may be waiting
+      std::atomic<size_t> count{0};
+
+      Waiter *front() const noexcept { return static_cast<Waiter *>(head); }
+      void push_back(Waiter *w) noexcept
+      {
+        w->next = nullptr;
+        if(tail != nullptr)
+        {
+          tail->next = w;
+        }
+        else
+        {
+          head = w;
+        }
+        tail = w;
+      }
+      Waiter *pop_front() noexcept
+      {
+        auto *ret = static_cast<Waiter *>(head);
+        head = ret->next;
+        if(head == nullptr)
+        {
+          tail = nullptr;
+        }
+        count.fetch_sub(1, std::memory_order_seq_cst);
+        return ret;
+      }
+      // Removes every waiter, returning the first
+      channel_waiter *take_all() noexcept
+      {
+        channel_waiter *ret = head;
+        head = tail = nullptr;
+        count.store(0, std::memory_order_seq_cst);
+        return ret;
+      }
+    };
+
+    // Every consumer gets its own copy of the terminal error, which for move only status codes is a clone
+    template <class E> inline std::enable_if_t<std::is_copy_constructible<E>::value, E> copy_error(const E &e, int /*unused*/) { return e; }
+    template <class E> inline auto copy_error(const E &e, ...) -> decltype(E(e.clone())) { return e.clone(); }
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition template <class T> channel. Potential doc page: `channel<T>`
+*/
+  template <class T> class channel
+  {
+    static_assert(std::is_nothrow_move_constructible<T>::value, "channel<T> needs a T which is nothrow move constructible");
+
+  public:
+    //! The type of item sent and received, a result or outcome.
+    using value_type = T;
+    //! The type of the terminal error with which the channel is closed.
+    using error_type = typename T::error_type;
+    //! The type returned by awaiting `send()`.
+    using send_result_type = typename T::template rebind<void>;
+
+    class send_awaiter;
+    class receive_awaiter;
+
+  private:
+    detail::bounded_ring<T> _ring;
+    std::mutex _lock;
+    detail::channel_waiters<send_awaiter> _senders;
+    detail::channel_waiters<receive_awaiter> _receivers;
+    std::atomic<bool> _closed{false};
+    error_type _error{};  // written once under the lock, before _closed is set
+
+    // After an item was pushed, completes the oldest waiting receive with an item
+    void _wake_receiver() noexcept
+    {
+      if(_receivers.count.load(std::memory_order_seq_cst) == 0)
+      {
+        return;
+      }
+      receive_awaiter *r;
+      {
+        std::lock_guard<std::mutex> g(_lock);
+        r = _receivers.front();
+        if(r == nullptr || !_ring.try_pop(r->_storage))
+        {
+          return;
+        }
+        _receivers.pop_front();
+        r->_received = true;
+      }
+      _wake_sender();  // the pop made room
+      r->handle.resume();
+    }
+    // After an item was popped, completes the oldest waiting send
+    void _wake_sender() noexcept
+    {
+      if(_senders.count.load(std::memory_order_seq_cst) == 0)
+      {
+        return;
+      }
+      send_awaiter *s;
+      {
+        std::lock_guard<std::mutex> g(_lock);
+        s = _senders.front();
+        if(s == nullptr || !_ring.try_push(s->_value))
+        {
+          return;
+        }
+        _senders.pop_front();
+        s->_sent = true;
+      }
+      _wake_receiver();  // the push made an item
+      s->handle.resume();
+    }
+
+  public:
+    //! Awaiting this sends an item, suspending while the channel is full.
+    class OUTCOME_NODISCARD send_awaiter : detail::channel_waiter
+    {
+      friend class channel;
+      friend struct detail::channel_waiters<send_awaiter>;
+
+      channel *_ch;
+      T _value;
+      bool _sent{false};
+
+    public:
+      send_awaiter(channel *ch, T &&v) noexcept
+          : _ch(ch)
+          , _value(static_cast<T &&>(v))
+      {
+      }
+
+      bool await_ready() noexcept
+      {
+        if(_ch->_closed.load(std::memory_order_acquire))
+        {
+          return true;
+        }
+        if(_ch->_ring.try_push(_value))
+        {
+          _sent = true;
+          _ch->_wake_receiver();
+          return true;
+        }
+        return false;
+      }
+      bool await_suspend(coroutine_handle<> h) noexcept
+      {
+        {
+          std::lock_guard<std::mutex> g(_ch->_lock);
+          if(_ch->_closed.load(std::memory_order_relaxed))
+          {
+            return false;
+          }
+          _ch->_senders.count.fetch_add(1, std::memory_order_seq_cst);
+          if(!_ch->_ring.try_push(_value))
+          {
+            handle = h;
+            _ch->_senders.push_back(this);
+            return true;
+          }
+          _ch->_senders.count.fetch_sub(1, std::memory_order_seq_cst);
+          _sent = true;
+        }
+        _ch->_wake_receiver();
+        return false;
+      }
+      //! Success, or the terminal error if the channel was closed before the item could be sent.
+      send_result_type await_resume()
+      {
+        if(_sent)
+        {
+          return send_result_type(OUTCOME_V2_NAMESPACE::success());
+        }
+        return send_result_type(in_place_type<error_type>, detail::copy_error(_ch->_error, 0));
+      }
+    };
+
+    //! Awaiting this receives an item, suspending while the channel is empty.
+    class OUTCOME_NODISCARD receive_awaiter : detail::channel_waiter
+    {
+      friend class channel;
+      friend struct detail::channel_waiters<receive_awaiter>;
+
+      channel *_ch;
+      alignas(T) unsigned char _storage[sizeof(T)];
+      bool _received{false};
+
+      T *_item() noexcept { return reinterpret_cast<T *>(_storage); }
+
+    public:
+      explicit receive_awaiter(channel *ch) noexcept
+          : _ch(ch)
+      {
+      }
+      receive_awaiter(const receive_awaiter &) = delete;
+      receive_awaiter(receive_awaiter &&o) noexcept
+          : _ch(o._ch)
+          , _received(o._received)
+      {
+        if(_received)
+        {
+          new(_storage) T(static_cast<T &&>(*o._item()));
+        }
+      }
+      receive_awaiter &operator=(const receive_awaiter &) = delete;
+      receive_awaiter &operator=(receive_awaiter &&) = delete;
+      ~receive_awaiter()
+      {
+        if(_received)
+        {
+          _item()->~T();
+        }
+      }
+
+      bool await_ready() noexcept
+      {
+        if(_ch->_ring.try_pop(_storage))
+        {
+          _received = true;
+          _ch->_wake_sender();
+          return true;
+        }
+        return _ch->_closed.load(std::memory_order_acquire);
+      }
+      bool await_suspend(coroutine_handle<> h) noexcept
+      {
+        {
+          std::lock_guard<std::mutex> g(_ch->_lock);
+          _ch->_receivers.count.fetch_add(1, std::memory_order_seq_cst);
+          if(!_ch->_ring.try_pop(_storage))
+          {
+            if(!_ch->_closed.load(std::memory_order_relaxed))
+            {
+              handle = h;
+              _ch->_receivers.push_back(this);
+              return true;
+            }
+            _ch->_receivers.count.fetch_sub(1, std::memory_order_seq_cst);
+            return false;
+          }
+          _ch->_receivers.count.fetch_sub(1, std::memory_order_seq_cst);
+          _received = true;
+        }
+        _ch->_wake_sender();
+        return false;
+      }
+      //! The item, or the terminal error if the channel was closed and no items remain.
+      T await_resume()
+      {
+        if(_received)
+        {
+          return static_cast<T &&>(*_item());
+        }
+        return T(in_place_type<error_type>, detail::copy_error(_ch->_error, 0));
+      }
+    };
+
+    //! Constructs a channel holding up to `capacity` items, rounded up to a power of two of at least two.
+    explicit channel(size_t capacity)
+        : _ring(capacity)
+    {
+    }
+    channel(const channel &) = delete;
+    channel(channel &&) = delete;
+    channel &operator=(const channel &) = delete;
+    channel &operator=(channel &&) = delete;
+    //! Destroys any items not received. No coroutine may be waiting on the channel.
+    ~channel() = default;
+
+    //! The number of items the channel can hold.
+    size_t capacity() const noexcept { return _ring.capacity(); }
+    //! True if the channel has been closed.
+    bool is_closed() const noexcept { return _closed.load(std::memory_order_acquire); }
+
+    //! Returns an awaitable which sends `v`, suspending the sender while the channel is full.
+    send_awaiter send(T v) noexcept { return send_awaiter(this, static_cast<T &&>(v)); }
+    //! Returns an awaitable which receives the oldest item, suspending the receiver while the channel is empty.
+    receive_awaiter receive() noexcept { return receive_awaiter(this); }
+
+    /*! Closes the channel with the terminal error `e`. Waiting and future sends complete
+    with `e`. Receives return the items remaining in the channel, then `e`. Only the first
+    close has any effect.
+    */
+    void close(error_type e)
+    {
+      detail::channel_waiter *senders, *receivers;
+      {
+        std::lock_guard<std::mutex> g(_lock);
+        if(_closed.load(std::memory_order_relaxed))
+        {
+          return;
+        }
+        _error = static_cast<error_type &&>(e);
+        _closed.store(true, std::memory_order_release);
+        senders = _senders.take_all();
+        receivers = _receivers.take_all();
+        for(detail::channel_waiter *w = receivers; w != nullptr; w = w->next)
+        {
+          auto *r = static_cast<receive_awaiter *>(w);
+          r->_received = _ring.try_pop(r->_storage);
+        }
+      }
+      _resume_all(senders);
+      _resume_all(receivers);
+    }
+
+  private:
+    static void _resume_all(detail::channel_waiter *w) noexcept
+    {
+      while(w != nullptr)
+      {
+        detail::channel_waiter *next = w->next;  // the resumed coroutine may destroy its awaiter
+        w->handle.resume();
+        w = next;
+      }
+    }
+  };
+}  // namespace awaitables
+OUTCOME_V2_NAMESPACE_END
+
+#endif
+
+#endif
@@ -0,0 +1,249 @@
+/* Out of line storage for large error payloads
+(C) 2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2020
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_COLD_ERROR_HPP
+#define OUTCOME_COLD_ERROR_HPP
+
+#include "result.hpp"
+
+#include <cstddef>
+#include <new>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  /* A per-thread cache of freed blocks of the same size class, so repeated failures
+  on a thread do not go to the global allocator. Blocks freed on another thread join
+  that thread's cache.
+  */
+  template <size_t Size> struct cold_error_pool
+  {
+    static constexpr size_t max_cached = 64;
+
+    struct node
+    {
+      node *next;
+    };
+    struct cache
+    {
+      node *head{nullptr};
+      size_t count{0};
+      bool disabled{false};
+      cache() = default;
+      cache(const cache &) = delete;
+      cache &operator=(const cache &) = delete;
+      ~cache()
+      {
+        while(head != nullptr)
+        {
+          node *n = head;
+          head = n->next;
+          ::operator delete(n);
+        }
+        // Blocks freed by thread local destructors running after this one go straight to the allocator
+        disabled = true;
+      }
+    };
+    static cache &_cache() noexcept
+    {
+      static thread_local cache c;
+      return c;
+    }
+
+    static void *allocate()
+    {
+      cache &c = _cache();
+      if(c.head != nullptr)
+      {
+        node *n = c.head;
+        c.head = n->next;
+        --c.count;
+        return n;
+      }
+      return ::operator new(Size);
+    }
+    static void deallocate(void *p) noexcept
+    {
+      cache &c = _cache();
+      if(c.disabled || c.count >= max_cached)
+      {
+        ::operator delete(p);
+        return;
+      }
+      node *n = static_cast<node *>(p);
+      n->next = c.head;
+      c.head = n;
+      ++c.count;
+    }
+  };
+  // Size classes are multiples of 16 bytes, so similarly sized payloads share a cache
+  template <class E> using cold_error_pool_for = cold_error_pool<(sizeof(E) + 15) / 16 * 16>;
+
+  namespace cold_error_adl
+  {
+    using OUTCOME_V2_NAMESPACE::policy::outcome_throw_as_system_error_with_payload;
+    using OUTCOME_V2_NAMESPACE::policy::detail::make_error_code;
+
+    template <class E> inline auto error_code(const E &v) -> decltype(make_error_code(v)) { return make_error_code(v); }
+    template <class E> inline void throw_as_system_error_with_payload(const E &v) { outcome_throw_as_system_error_with_payload(v); }
+  }  // namespace cold_error_adl
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+type definition template <class E> cold_error. Potential doc page: `cold_error<E>`
+*/
+template <class E> class cold_error
+{
+  static_assert(std::is_object<E>::value && !std::is_array<E>::value, "cold_error needs a non-array object type");
+  static_assert(alignof(E) <= alignof(std::max_align_t), "cold_error cannot store over-aligned types");
+
+  using _pool = detail::cold_error_pool_for<E>;
+
+  E *_ptr{nullptr};
+
+  template <class... Args> static E *_make(Args &&... args)
+  {
+    void *p = _pool::allocate();
+#ifdef __cpp_exceptions
+    try
+    {
+      return new(p) E(static_cast<Args &&>(args)...);
+    }
+    catch(...)
+    {
+      _pool::deallocate(p);
+      throw;
+    }
+#else
+    return new(p) E(static_cast<Args &&>(args)...);
+#endif
+  }
+  void _release() noexcept
+  {
+    if(_ptr != nullptr)
+    {
+      _ptr->~E();
+      _pool::deallocate(_ptr);
+      _ptr = nullptr;
+    }
+  }
+
+public:
+  //! The type of the payload.
+  using element_type = E;
+
+  //! Default constructor, holds no payload.
+  cold_error() = default;
+  //! Constructs a payload out of line from `args`.
+  template <class... Args>
+  explicit cold_error(in_place_type_t<E> /*unused*/, Args &&... args)
+      : _ptr(_make(static_cast<Args &&>(args)...))
+  {
+  }
+  //! Implicit construction from a payload, copying it out of line.
+  cold_error(const E &v)  // NOLINT
+      : _ptr(_make(v))
+  {
+  }
+  //! Implicit construction from a payload, moving it out of line.
+  cold_error(E &&v)  // NOLINT
+      : _ptr(_make(static_cast<E &&>(v)))
+  {
+  }
+  //! Copy constructor, copying the payload into a new block.
+  cold_error(const cold_error &o)
+      : _ptr((o._ptr != nullptr) ? _make(*o._ptr) : nullptr)
+  {
+  }
+  //! Move constructor, transferring the payload. The source no longer holds a payload.
+  cold_error(cold_error &&o) noexcept
+      : _ptr(o._ptr)
+  {
+    o._ptr = nullptr;
+  }
+  cold_error &operator=(const cold_error &o)
+  {
+    if(this != &o)
+    {
+      cold_error temp(o);
+      _release();
+      _ptr = temp._ptr;
+      temp._ptr = nullptr;
+    }
+    return *this;
+  }
+  cold_error &operator=(cold_error &&o) noexcept
+  {
+    if(this != &o)
+    {
+      _release();
+      _ptr = o._ptr;
+      o._ptr = nullptr;
+    }
+    return *this;
+  }
+  ~cold_error() { _release(); }
+
+  //! True if a payload is held.
+  explicit operator bool() const noexcept { return _ptr != nullptr; }
+  //! The payload, which must be held.
+  E &operator*() noexcept { return *_ptr; }
+  //! The payload, which must be held.
+  const E &operator*() const noexcept { return *_ptr; }
+  E *operator->() noexcept { return _ptr; }
+  const E *operator->() const noexcept { return _ptr; }
+  //! A pointer to the payload, or null.
+  E *get() noexcept { return _ptr; }
+  const E *get() const noexcept { return _ptr; }
+
+  //! Compares the payloads of two cold errors, which must both be held.
+  OUTCOME_TEMPLATE(class U = E)
+  OUTCOME_TREQUIRES(OUTCOME_TEXPR(std::declval<const U &>() == std::declval<const U &>()))
+  friend bool operator==(const cold_error &a, const cold_error &b) noexcept(noexcept(*a == *b)) { return *a == *b; }
+  OUTCOME_TEMPLATE(class U = E)
+  OUTCOME_TREQUIRES(OUTCOME_TEXPR(std::declval<const U &>() == std::declval<const U &>()))
+  friend bool operator!=(const cold_error &a, const cold_error &b) noexcept(noexcept(*a == *b)) { return !(*a == *b); }
+
+  //! The error code of the payload, if the payload has one. Makes `cold_error<E>` an error code type if `E` is.
+  template <class U = E> friend auto make_error_code(const cold_error &e) -> decltype(detail::cold_error_adl::error_code(std::declval<const U &>()))
+  {
+    return detail::cold_error_adl::error_code(*e);
+  }
+  //! Passes the payload to the `outcome_throw_as_system_error_with_payload()` for `E`.
+  friend void outcome_throw_as_system_error_with_payload(const cold_error &e) { detail::cold_error_adl::throw_as_system_error_with_payload(*e); }
+};
+
+namespace trait
+{
+  // A moved-from cold_error holds nothing, so it is move bitcopying
+  template <class E> struct is_move_bitcopying<cold_error<E>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -170,6 +170,18 @@ OUTCOME_V2_NAMESPACE_END
 #endif
 #endif
 
+#ifndef OUTCOME_ENABLE_PACKED_STORAGE
+//! Defined to 1 to pad trivial `basic_result` storage of up to 16 bytes out to whole 64 bit registers, so it is
+//! passed and returned in registers with no stack spills. This changes layout and so ABI, so defaults to 0.
+#define OUTCOME_ENABLE_PACKED_STORAGE 0
+#endif
+
+#ifndef OUTCOME_ENABLE_COMPACT_STATUS
+//! Defined to 1 to shrink the status of `basic_result` and `basic_outcome` to one byte, by dropping the storage behind
+//! `hooks::spare_storage()` which then always returns zero. This changes layout and so ABI, so defaults to 0.
+#define OUTCOME_ENABLE_COMPACT_STATUS 0
+#endif
+
 OUTCOME_V2_NAMESPACE_BEGIN
 namespace detail
 {
@@ -126,17 +126,46 @@ namespace detail
     {
     };
     template <class T, class U, class V>
-    constexpr basic_result_storage(compatible_conversion_tag /*unused*/, const basic_result_storage<T, U, V> &o) noexcept(
+    constexpr basic_result_storage(compatible_conversion_tag _, const basic_result_storage<T, U, V> &o) noexcept(
+    detail::is_nothrow_constructible<_value_type, T> &&detail::is_nothrow_constructible<_error_type, U>)
+        : basic_result_storage(_, o, std::integral_constant<bool, std::is_constructible<_state_type, const decltype(o._state) &>::value>())
+    {
+    }
+    template <class T, class U, class V>
+    constexpr basic_result_storage(compatible_conversion_tag _, basic_result_storage<T, U, V> &&o) noexcept(
+    detail::is_nothrow_constructible<_value_type, T> &&detail::is_nothrow_constructible<_error_type, U>)
+        : basic_result_storage(_, static_cast<basic_result_storage<T, U, V> &&>(o),
+                               std::integral_constant<bool, std::is_constructible<_state_type, decltype(o._state) &&>::value>())
+    {
+    }
+    // Storages of the same kind know how to convert between themselves
+    template <class T, class U, class V>
+    constexpr basic_result_storage(compatible_conversion_tag /*unused*/, const basic_result_storage<T, U, V> &o, std::true_type /*unused*/) noexcept(
     detail::is_nothrow_constructible<_value_type, T> &&detail::is_nothrow_constructible<_error_type, U>)
         : _state(o._state)
     {
     }
     template <class T, class U, class V>
-    constexpr basic_result_storage(compatible_conversion_tag /*unused*/, basic_result_storage<T, U, V> &&o) noexcept(
+    constexpr basic_result_storage(compatible_conversion_tag /*unused*/, basic_result_storage<T, U, V> &&o, std::true_type /*unused*/) noexcept(
     detail::is_nothrow_constructible<_value_type, T> &&detail::is_nothrow_constructible<_error_type, U>)
         : _state(static_cast<decltype(o._state) &&>(o._state))
     {
     }
+    // Otherwise (e.g. to or from niche storage) convert the value or error
+    template <class T, class U, class V>
+    constexpr basic_result_storage(compatible_conversion_tag /*unused*/, const basic_result_storage<T, U, V> &o, std::false_type /*unused*/) noexcept(
+    detail::is_nothrow_constructible<_value_type, T> &&detail::is_nothrow_constructible<_error_type, U>)
+        : _state(o._state._status.have_value() ? _state_type(in_place_type<_value_type>, o._state._value) :
+                                                 _state_type(in_place_type<_error_type>, o._state._error))
+    {
+    }
+    template <class T, class U, class V>
+    constexpr basic_result_storage(compatible_conversion_tag /*unused*/, basic_result_storage<T, U, V> &&o, std::false_type /*unused*/) noexcept(
+    detail::is_nothrow_constructible<_value_type, T> &&detail::is_nothrow_constructible<_error_type, U>)
+        : _state(o._state._status.have_value() ? _state_type(in_place_type<_value_type>, static_cast<decltype(o._state._value) &&>(o._state._value)) :
+                                                 _state_type(in_place_type<_error_type>, static_cast<decltype(o._state._error) &&>(o._state._error)))
+    {
+    }
 
     struct make_error_code_compatible_conversion_tag
     {
@@ -0,0 +1,55 @@
+/* Common to the headers of awaitables built upon coroutine support
+(C) 2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2020
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_DETAIL_COROUTINE_AWAITABLES_HPP
+#define OUTCOME_DETAIL_COROUTINE_AWAITABLES_HPP
+
+#include "../config.hpp"
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace awaitables
+{
+  namespace detail
+  {
+    // An address which no object has, for atomics holding either a pointer or one of a few states
+    template <int N> inline void *state_sentinel() noexcept
+    {
+      static char v;
+      return &v;
+    }
+    inline void *completed_state() noexcept { return state_sentinel<0>(); }
+    inline void *detached_state() noexcept { return state_sentinel<1>(); }
+  }  // namespace detail
+}  // namespace awaitables
+OUTCOME_V2_NAMESPACE_END
+
+/* The awaitables are defined by coroutine_support.ipp, which outcome/coroutine_support.hpp
+and outcome/experimental/coroutine_support.hpp both include, so the headers building upon
+the awaitables work with whichever of the two was included first, else the former.
+*/
+#ifndef OUTCOME_DETAIL_COROUTINE_SUPPORT_HPP
+#include "../coroutine_support.hpp"
+#endif
+
+#endif
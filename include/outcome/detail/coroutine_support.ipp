@@ -29,8 +29,21 @@ Distributed under the Boost Software License, Version 1.0.
 #ifndef OUTCOME_DETAIL_COROUTINE_SUPPORT_HPP
 #define OUTCOME_DETAIL_COROUTINE_SUPPORT_HPP
 
+#include "../success_failure.hpp"
+#include "coroutine_awaitables.hpp"
+
 #include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>  // for std::allocator_traits
+#include <mutex>
+#include <new>
+#include <thread>  // for std::this_thread
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #if __cpp_impl_coroutine || (defined(_MSC_VER) && __cpp_coroutines) || (defined(__clang__) && __cpp_coroutines)
 #ifndef OUTCOME_HAVE_NOOP_COROUTINE
@@ -41,7 +54,7 @@ Distributed under the Boost Software License, Version 1.0.
 #endif
 #endif
 #ifndef OUTCOME_HAVE_NOOP_COROUTINE
-#if _MSC_VER >= 1928
+#if _MSC_VER >= 1928 || (__cpp_impl_coroutine && __has_include(<coroutine>))
 #define OUTCOME_HAVE_NOOP_COROUTINE 1
 #else
 #define OUTCOME_HAVE_NOOP_COROUTINE 0
@@ -79,8 +92,16 @@ OUTCOME_V2_NAMESPACE_END
 #define OUTCOME_FOUND_COROUTINE_HEADER 1
 #endif
 #endif
+#ifndef OUTCOME_COROUTINE_FRAME_POOL
+#define OUTCOME_COROUTINE_FRAME_POOL 1  // Pool coroutine frames in per-thread free lists
+#endif
 
 OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+template <class R, class S, class NoValuePolicy>  //
+class basic_result;
+template <class R, class S, class P, class NoValuePolicy>  //
+class basic_outcome;
+
 namespace awaitables
 {
   namespace detail
@@ -126,7 +147,532 @@ namespace awaitables
     };
 
 #ifdef OUTCOME_FOUND_COROUTINE_HEADER
-    template <class Awaitable, bool suspend_initial, bool use_atomic, bool is_void> struct outcome_promise_type
+    /* A per-thread cache of freed coroutine frames, one free list per size class.
+    Frames freed on another thread join that thread's cache.
+    */
+    struct coroutine_frame_pool
+    {
+      static constexpr size_t granularity = 64;
+      static constexpr size_t classes = 32;  // frames up to 2Kb are pooled
+      static constexpr size_t max_cached = 64;
+
+      struct node
+      {
+        node *next;
+      };
+      struct cache
+      {
+        node *heads[classes]{};
+        size_t counts[classes]{};
+        bool disabled{false};
+        cache() = default;
+        cache(const cache &) = delete;
+        cache &operator=(const cache &) = delete;
+        ~cache()
+        {
+          for(auto &head : heads)
+          {
+            while(head != nullptr)
+            {
+              node *n = head;
+              head = n->next;
+              ::operator delete(n);
+            }
+          }
+          // Frames freed by thread local destructors running after this one go straight to the allocator
+          disabled = true;
+        }
+      };
+      static cache &_cache() noexcept
+      {
+        static thread_local cache c;
+        return c;
+      }
+
+      static void *allocate(size_t bytes)
+      {
+        const size_t idx = (bytes - 1) / granularity;
+        if(!OUTCOME_COROUTINE_FRAME_POOL || idx >= classes)
+        {
+          return ::operator new(bytes);
+        }
+        cache &c = _cache();
+        if(c.heads[idx] != nullptr)
+        {
+          node *n = c.heads[idx];
+          c.heads[idx] = n->next;
+          --c.counts[idx];
+          return n;
+        }
+        return ::operator new((idx + 1) * granularity);
+      }
+      static void deallocate(void *p, size_t bytes) noexcept
+      {
+        const size_t idx = (bytes - 1) / granularity;
+        if(!OUTCOME_COROUTINE_FRAME_POOL || idx >= classes)
+        {
+          ::operator delete(p);
+          return;
+        }
+        cache &c = _cache();
+        if(c.disabled || c.counts[idx] >= max_cached)
+        {
+          ::operator delete(p);
+          return;
+        }
+        node *n = static_cast<node *>(p);
+        n->next = c.heads[idx];
+        c.heads[idx] = n;
+        ++c.counts[idx];
+      }
+    };
+
+    /* Allocation of coroutine frames for promise types. Each frame is followed by a
+    pointer to the function which frees it, and then by the allocator if one was
+    supplied using `std::allocator_arg`.
+    */
+    struct coroutine_frame_allocation
+    {
+      using deallocate_function = void (*)(void *, size_t) noexcept;
+      struct alignas(std::max_align_t) frame_block
+      {
+        char _[alignof(std::max_align_t)];
+      };
+
+      static constexpr size_t _round(size_t bytes, size_t align) noexcept { return (bytes + align - 1) & ~(align - 1); }
+      static constexpr size_t _tail_offset(size_t bytes) noexcept { return _round(bytes, alignof(deallocate_function)); }
+      template <class Alloc> static constexpr size_t _allocator_offset(size_t bytes) noexcept { return _round(_tail_offset(bytes) + sizeof(deallocate_function), alignof(Alloc)); }
+      template <class Alloc> static constexpr size_t _blocks(size_t bytes) noexcept { return (_allocator_offset<Alloc>(bytes) + sizeof(Alloc) + sizeof(frame_block) - 1) / sizeof(frame_block); }
+      static deallocate_function &_tail(void *p, size_t bytes) noexcept { return *reinterpret_cast<deallocate_function *>(static_cast<char *>(p) + _tail_offset(bytes)); }
+
+      static void _deallocate_default(void *p, size_t bytes) noexcept { coroutine_frame_pool::deallocate(p, _tail_offset(bytes) + sizeof(deallocate_function)); }
+      template <class Alloc> static void _deallocate_with(void *p, size_t bytes) noexcept
+      {
+        using block_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<frame_block>;
+        auto *a = reinterpret_cast<block_allocator *>(static_cast<char *>(p) + _allocator_offset<block_allocator>(bytes));
+        block_allocator alloc(static_cast<block_allocator &&>(*a));
+        a->~block_allocator();
+        std::allocator_traits<block_allocator>::deallocate(alloc, static_cast<frame_block *>(p), _blocks<block_allocator>(bytes));
+      }
+      template <class Alloc> static void *_allocate_with(size_t bytes, const Alloc &a)
+      {
+        using block_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<frame_block>;
+        block_allocator alloc(a);
+        void *p = std::allocator_traits<block_allocator>::allocate(alloc, _blocks<block_allocator>(bytes));
+        new(static_cast<char *>(p) + _allocator_offset<block_allocator>(bytes)) block_allocator(static_cast<block_allocator &&>(alloc));
+        _tail(p, bytes) = &_deallocate_with<Alloc>;
+        return p;
+      }
+
+      //! Allocates the coroutine frame from the per-thread frame pool.
+      static void *operator new(size_t bytes)
+      {
+        void *p = coroutine_frame_pool::allocate(_tail_offset(bytes) + sizeof(deallocate_function));
+        _tail(p, bytes) = &_deallocate_default;
+        return p;
+      }
+      //! Allocates the coroutine frame using the allocator passed after `std::allocator_arg` to a free function.
+      template <class Alloc, class... Args> static void *operator new(size_t bytes, std::allocator_arg_t /*unused*/, const Alloc &a, const Args &... /*unused*/)
+      {
+        return _allocate_with(bytes, a);
+      }
+      //! Allocates the coroutine frame using the allocator passed after `std::allocator_arg` to a member function.
+      template <class This, class Alloc, class... Args> static void *operator new(size_t bytes, const This & /*unused*/, std::allocator_arg_t /*unused*/, const Alloc &a, const Args &... /*unused*/)
+      {
+        return _allocate_with(bytes, a);
+      }
+      static void operator delete(void *p, size_t bytes) noexcept { _tail(p, bytes)(p, bytes); }
+    };
+
+    /* Handshake between the final suspend of an atomic coroutine and a thread blocked in
+    sync_wait() upon it. The thread parks only after announcing itself, so coroutines nobody
+    is blocked upon never notify, and it waits for `finished` before destroying the frame.
+    */
+    struct sync_wait_states
+    {
+      static constexpr int running = 0, parked = 1, waking = 2, finished = 3;
+    };
+    inline void finish_sync_wait(std::atomic<int> &state) noexcept
+    {
+#if __cpp_lib_atomic_wait
+      if(state.exchange(sync_wait_states::waking, std::memory_order_acq_rel) == sync_wait_states::parked)
+      {
+        state.notify_all();
+      }
+#endif
+      state.store(sync_wait_states::finished, std::memory_order_release);
+    }
+    inline void finish_sync_wait(fake_atomic<int> & /*unused*/) noexcept {}
+    inline void wait_until_finished(std::atomic<int> &state) noexcept
+    {
+      int s = sync_wait_states::running;
+#if __cpp_lib_atomic_wait
+      if(state.compare_exchange_strong(s, sync_wait_states::parked, std::memory_order_acq_rel))
+      {
+        s = sync_wait_states::parked;
+        while(s == sync_wait_states::parked)
+        {
+          state.wait(sync_wait_states::parked, std::memory_order_acquire);
+          s = state.load(std::memory_order_acquire);
+        }
+      }
+#endif
+      // Either no blocking wait is available, or the final suspend is part way through notifying
+      while(s != sync_wait_states::finished)
+      {
+        std::this_thread::yield();
+        s = state.load(std::memory_order_acquire);
+      }
+    }
+
+    /* Registered with a cancellation token by awaitables which can abandon an operation
+    they are suspended upon. Invoked by the thread requesting cancellation, after being
+    deregistered, without the token's lock held.
+    */
+    struct cancellation_callback
+    {
+      void (*invoke)(cancellation_callback *) noexcept{nullptr};
+      cancellation_callback *prev{nullptr}, *next{nullptr};
+    };
+
+    // The state shared between a cancellation_source and its tokens
+    struct cancellation_state
+    {
+      std::atomic<size_t> refs{1};
+      std::atomic<bool> requested{false};
+      std::mutex lock;
+      cancellation_callback *callbacks{nullptr};
+      cancellation_callback *invoking{nullptr};  // the callback being invoked, if any
+      std::thread::id invoker;                   // the thread invoking it
+
+      void add_ref() noexcept { refs.fetch_add(1, std::memory_order_relaxed); }
+      void release() noexcept
+      {
+        if(refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+          delete this;
+        }
+      }
+
+      // Returns false without registering if cancellation has already been requested
+      bool add(cancellation_callback *cb) noexcept
+      {
+        std::lock_guard<std::mutex> g(lock);
+        if(requested.load(std::memory_order_acquire))
+        {
+          return false;
+        }
+        cb->prev = nullptr;
+        cb->next = callbacks;
+        if(callbacks != nullptr)
+        {
+          callbacks->prev = cb;
+        }
+        callbacks = cb;
+        return true;
+      }
+      /* Returns true if the callback was deregistered before being invoked. Otherwise it has
+      been invoked, and if that is still under way on another thread, waits for it to return.
+      */
+      bool remove(cancellation_callback *cb) noexcept
+      {
+        std::unique_lock<std::mutex> g(lock);
+        if(_unlink(cb))
+        {
+          return true;
+        }
+        while(invoking == cb && invoker != std::this_thread::get_id())
+        {
+          g.unlock();
+          std::this_thread::yield();
+          g.lock();
+        }
+        return false;
+      }
+      // Invokes the callbacks once requested is set, each deregistered before its invocation
+      void invoke_callbacks() noexcept
+      {
+        std::unique_lock<std::mutex> g(lock);
+        while(callbacks != nullptr)
+        {
+          cancellation_callback *cb = callbacks;
+          _unlink(cb);
+          invoking = cb;
+          invoker = std::this_thread::get_id();
+          g.unlock();
+          cb->invoke(cb);  // may destroy cb
+          g.lock();
+          invoking = nullptr;
+        }
+      }
+
+    private:
+      bool _unlink(cancellation_callback *cb) noexcept
+      {
+        if(cb->prev != nullptr)
+        {
+          cb->prev->next = cb->next;
+        }
+        else if(callbacks == cb)
+        {
+          callbacks = cb->next;
+        }
+        else
+        {
+          return false;  // not registered
+        }
+        if(cb->next != nullptr)
+        {
+          cb->next->prev = cb->prev;
+        }
+        cb->prev = cb->next = nullptr;
+        return true;
+      }
+    };
+
+    class cancellation_source;
+    class cancellation_token
+    {
+      friend class cancellation_source;
+
+      cancellation_state *_state{nullptr};
+
+      explicit cancellation_token(cancellation_state *s) noexcept
+          : _state(s)
+      {
+        _state->add_ref();
+      }
+
+    public:
+      //! Default constructor, a token which can never be cancelled.
+      cancellation_token() = default;
+      cancellation_token(const cancellation_token &o) noexcept
+          : _state(o._state)
+      {
+        if(_state != nullptr)
+        {
+          _state->add_ref();
+        }
+      }
+      cancellation_token(cancellation_token &&o) noexcept
+          : _state(o._state)
+      {
+        o._state = nullptr;
+      }
+      cancellation_token &operator=(const cancellation_token &o) noexcept
+      {
+        cancellation_token temp(o);
+        std::swap(_state, temp._state);
+        return *this;
+      }
+      cancellation_token &operator=(cancellation_token &&o) noexcept
+      {
+        std::swap(_state, o._state);
+        return *this;
+      }
+      ~cancellation_token()
+      {
+        if(_state != nullptr)
+        {
+          _state->release();
+        }
+      }
+
+      //! True if this token was obtained from a `cancellation_source`.
+      bool can_be_cancelled() const noexcept { return _state != nullptr; }
+      //! True if cancellation has been requested from the source of this token.
+      bool is_cancellation_requested() const noexcept { return _state != nullptr && _state->requested.load(std::memory_order_acquire); }
+
+      // Registers a callback to be invoked when cancellation is requested, returning false if it already has been
+      bool _add_callback(cancellation_callback *cb) const noexcept { return _state != nullptr && _state->add(cb); }
+      // Deregisters a callback, returning false if it has already been invoked, once that invocation has returned
+      bool _remove_callback(cancellation_callback *cb) const noexcept { return _state != nullptr && _state->remove(cb); }
+    };
+
+    class cancellation_source
+    {
+      cancellation_state *_state;
+
+    public:
+      cancellation_source()
+          : _state(new cancellation_state)  // could throw
+      {
+      }
+      cancellation_source(const cancellation_source &o) noexcept
+          : _state(o._state)
+      {
+        _state->add_ref();
+      }
+      cancellation_source &operator=(const cancellation_source &) = delete;
+      cancellation_source &operator=(cancellation_source &&) = delete;
+      ~cancellation_source() { _state->release(); }
+
+      //! A token which observes cancellation requested from this source.
+      cancellation_token token() const noexcept { return cancellation_token(_state); }
+      //! Requests cancellation of everything holding a token from this source. Returns false if already requested.
+      bool request_cancellation() noexcept
+      {
+        if(_state->requested.exchange(true, std::memory_order_acq_rel))
+        {
+          return false;
+        }
+        _state->invoke_callbacks();
+        return true;
+      }
+      //! True if cancellation has been requested.
+      bool is_cancellation_requested() const noexcept { return _state->requested.load(std::memory_order_acquire); }
+    };
+
+    // The first cancellation_token among the parameters of a coroutine, if any
+    inline cancellation_token find_cancellation_token() noexcept { return {}; }
+    template <class... Args> inline cancellation_token find_cancellation_token(const cancellation_token &t, const Args &... /*unused*/) noexcept { return t; }
+    template <class T, class... Args> inline cancellation_token find_cancellation_token(const T & /*unused*/, const Args &... args) noexcept { return find_cancellation_token(args...); }
+
+    /* The error with which cancelled coroutines complete, for error types able to represent
+    errc::operation_canceled. Specialised by the status code coroutine support.
+    */
+    template <class E, class = void> struct cancelled_error
+    {
+      static constexpr bool value = false;
+    };
+    template <class E> struct cancelled_error<E, std::enable_if_t<OUTCOME_V2_NAMESPACE::detail::is_constructible<E, std::error_code>>>
+    {
+      static constexpr bool value = true;
+      static std::error_code make() noexcept { return std::make_error_code(std::errc::operation_canceled); }
+    };
+    template <class T> struct can_set_cancelled : cancelled_error<typename decltype(extract_error_type<T>(0))::type>
+    {
+    };
+
+    // Fetches the awaiter of an awaitable, which may be the awaitable itself
+    template <class T> inline auto get_awaiter(T &&v, int /*unused*/) -> decltype(static_cast<T &&>(v).operator co_await()) { return static_cast<T &&>(v).operator co_await(); }
+    template <class T> inline auto get_awaiter(T &&v, long /*unused*/) -> decltype(operator co_await(static_cast<T &&>(v))) { return operator co_await(static_cast<T &&>(v)); }
+    template <class T> inline T &&get_awaiter(T &&v, ...) { return static_cast<T &&>(v); }
+
+#if OUTCOME_HAVE_NOOP_COROUTINE
+    // Adapts the three kinds of await_suspend() to returning the coroutine to resume
+    template <class Awaiter, class Promise> inline auto suspend_to_handle(Awaiter &a, coroutine_handle<Promise> h, int /*unused*/) -> decltype(coroutine_handle<>(a.await_suspend(h))) { return a.await_suspend(h); }
+    template <class Awaiter, class Promise> inline auto suspend_to_handle(Awaiter &a, coroutine_handle<Promise> h, long /*unused*/) -> std::enable_if_t<std::is_same<decltype(a.await_suspend(h)), bool>::value, coroutine_handle<>>
+    {
+      if(a.await_suspend(h))
+      {
+        return noop_coroutine();
+      }
+      return h;
+    }
+    template <class Awaiter, class Promise> inline coroutine_handle<> suspend_to_handle(Awaiter &a, coroutine_handle<Promise> h, ...)
+    {
+      a.await_suspend(h);
+      return noop_coroutine();
+    }
+#else
+    // Adapts the three kinds of await_suspend() to returning whether to stay suspended
+    template <class Awaiter, class Promise> inline auto suspend_to_bool(Awaiter &a, coroutine_handle<Promise> h, int /*unused*/) -> decltype(coroutine_handle<>(a.await_suspend(h)), true)
+    {
+      a.await_suspend(h).resume();
+      return true;
+    }
+    template <class Awaiter, class Promise> inline auto suspend_to_bool(Awaiter &a, coroutine_handle<Promise> h, long /*unused*/) -> std::enable_if_t<std::is_same<decltype(a.await_suspend(h)), bool>::value, bool> { return a.await_suspend(h); }
+    template <class Awaiter, class Promise> inline bool suspend_to_bool(Awaiter &a, coroutine_handle<Promise> h, ...)
+    {
+      a.await_suspend(h);
+      return true;
+    }
+#endif
+
+    /* Wraps everything awaited by an Outcome coroutine, so if cancellation has been requested
+    the coroutine completes with errc::operation_canceled instead of suspending.
+    */
+    template <class Promise, class Awaiter> struct cancellable_awaiter
+    {
+      Promise *promise;
+      Awaiter awaiter;
+
+      bool await_ready() { return !promise->_cancellation_requested() && awaiter.await_ready(); }
+#if OUTCOME_HAVE_NOOP_COROUTINE
+      coroutine_handle<> await_suspend(coroutine_handle<Promise> h)
+      {
+        if(promise->_complete_cancelled())
+        {
+          coroutine_handle<> next = promise->continuation ? promise->continuation : noop_coroutine();
+          detail::finish_sync_wait(promise->sync_wait_state);
+          return next;
+        }
+        return detail::suspend_to_handle(awaiter, h, 0);
+      }
+#else
+      bool await_suspend(coroutine_handle<Promise> h)
+      {
+        if(promise->_complete_cancelled())
+        {
+          coroutine_handle<> next = promise->continuation;
+          detail::finish_sync_wait(promise->sync_wait_state);
+          if(next)
+          {
+            next.resume();
+          }
+          return true;
+        }
+        return detail::suspend_to_bool(awaiter, h, 0);
+      }
+#endif
+      decltype(auto) await_resume() { return static_cast<Awaiter &&>(awaiter).await_resume(); }
+    };
+    // Results and outcomes, which co_await within an Outcome coroutine unwraps
+    template <class T> struct is_result_or_outcome : std::false_type
+    {
+    };
+    template <class R, class S, class NoValuePolicy> struct is_result_or_outcome<OUTCOME_V2_NAMESPACE::basic_result<R, S, NoValuePolicy>> : std::true_type
+    {
+    };
+    template <class R, class S, class P, class NoValuePolicy> struct is_result_or_outcome<OUTCOME_V2_NAMESPACE::basic_outcome<R, S, P, NoValuePolicy>> : std::true_type
+    {
+    };
+    // Constructs the failure of a result directly from its error, or of an outcome via its failure
+    template <class C, class U> inline auto set_failure_from(C *p, U &&v, int /*unused*/) -> decltype(static_cast<U &&>(v).assume_exception(), void())
+    {
+      new(p) C(static_cast<U &&>(v).as_failure());
+    }
+    template <class C, class U> inline void set_failure_from(C *p, U &&v, ...) { new(p) C(in_place_type<typename C::error_type>, static_cast<U &&>(v).assume_error()); }
+
+    /* Returned by the await_transform() of Outcome coroutines for results. A valued result never
+    suspends, and an errored result completes the coroutine with its error, without a
+    failure_type temporary, and resumes the awaiter of the coroutine.
+    */
+    template <class Promise, class U> struct result_awaiter
+    {
+      Promise *promise;
+      U &&v;
+
+      bool await_ready() const noexcept { return v.has_value(); }
+#if OUTCOME_HAVE_NOOP_COROUTINE
+      coroutine_handle<> await_suspend(coroutine_handle<Promise> /*unused*/)
+      {
+        promise->_complete_with_failure_of(static_cast<U &&>(v));
+        coroutine_handle<> next = promise->continuation ? promise->continuation : noop_coroutine();
+        detail::finish_sync_wait(promise->sync_wait_state);
+        return next;
+      }
+#else
+      bool await_suspend(coroutine_handle<Promise> /*unused*/)
+      {
+        promise->_complete_with_failure_of(static_cast<U &&>(v));
+        coroutine_handle<> next = promise->continuation;
+        detail::finish_sync_wait(promise->sync_wait_state);
+        if(next)
+        {
+          next.resume();
+        }
+        return true;
+      }
+#endif
+      // As with .value(), an lvalue result gives an lvalue reference to its value, an rvalue result an rvalue reference
+      decltype(auto) await_resume() noexcept { return static_cast<U &&>(v).assume_value(); }
+    };
+    // Lazy children awaited by a coroutine without a token of their own inherit its token
+    template <class T> inline void inherit_cancellation_token(T & /*unused*/, const cancellation_token & /*unused*/) noexcept {}
+
+    template <class Awaitable, bool suspend_initial, bool use_atomic, bool is_void> struct outcome_promise_type : coroutine_frame_allocation
     {
       using container_type = typename Awaitable::container_type;
       using result_set_type = std::conditional_t<use_atomic, std::atomic<bool>, fake_atomic<bool>>;
@@ -137,8 +683,16 @@ namespace awaitables
       };
       result_set_type result_set{false};
       coroutine_handle<> continuation;
+      cancellation_token _token;
+      std::conditional_t<use_atomic, std::atomic<int>, fake_atomic<int>> sync_wait_state{sync_wait_states::running};
 
       outcome_promise_type() noexcept {}
+      // Takes the first cancellation_token among the coroutine's parameters
+      template <class... Args>
+      explicit outcome_promise_type(const Args &... args) noexcept
+          : _token(detail::find_cancellation_token(args...))
+      {
+      }
       outcome_promise_type(const outcome_promise_type &) = delete;
       outcome_promise_type(outcome_promise_type &&) = delete;
       outcome_promise_type &operator=(const outcome_promise_type &) = delete;
@@ -194,6 +748,36 @@ namespace awaitables
 #endif
         result_set.store(true, std::memory_order_release);
       }
+      bool _cancellation_requested() const noexcept { return detail::can_set_cancelled<container_type>::value && _token.is_cancellation_requested(); }
+      void _set_cancelled(std::true_type /*unused*/) { new(&result) container_type(detail::can_set_cancelled<container_type>::make()); }
+      void _set_cancelled(std::false_type /*unused*/) noexcept {}
+      // Completes the coroutine with errc::operation_canceled if cancellation has been requested
+      bool _complete_cancelled()
+      {
+        if(!_cancellation_requested() || result_set.load(std::memory_order_acquire))
+        {
+          return false;
+        }
+        _set_cancelled(std::integral_constant<bool, detail::can_set_cancelled<container_type>::value>());
+        result_set.store(true, std::memory_order_release);
+        return true;
+      }
+      // Completes the coroutine with the failure of an awaited result
+      template <class U> void _complete_with_failure_of(U &&v)
+      {
+        detail::set_failure_from(&result, static_cast<U &&>(v), 0);
+        result_set.store(true, std::memory_order_release);
+      }
+      template <class U, std::enable_if_t<!detail::is_result_or_outcome<std::decay_t<U>>::value, bool> = true> auto await_transform(U &&v)
+      {
+        inherit_cancellation_token(v, _token);  // ADL finds the overload for awaitable
+        using awaiter_type = decltype(detail::get_awaiter(static_cast<U &&>(v), 0));
+        return detail::cancellable_awaiter<outcome_promise_type, awaiter_type>{this, detail::get_awaiter(static_cast<U &&>(v), 0)};
+      }
+      template <class U, std::enable_if_t<detail::is_result_or_outcome<std::decay_t<U>>::value, bool> = true> detail::result_awaiter<outcome_promise_type, U> await_transform(U &&v) noexcept
+      {
+        return {this, static_cast<U &&>(v)};
+      }
       auto initial_suspend() noexcept
       {
         struct awaiter
@@ -213,14 +797,18 @@ namespace awaitables
 #if OUTCOME_HAVE_NOOP_COROUTINE
           coroutine_handle<> await_suspend(coroutine_handle<outcome_promise_type> self) noexcept
           {
-            return self.promise().continuation ? self.promise().continuation : noop_coroutine();
+            coroutine_handle<> next = self.promise().continuation ? self.promise().continuation : noop_coroutine();
+            detail::finish_sync_wait(self.promise().sync_wait_state);  // the frame may be destroyed from here on
+            return next;
           }
 #else
-          void await_suspend(coroutine_handle<outcome_promise_type> self)
+          void await_suspend(coroutine_handle<outcome_promise_type> self) noexcept
           {
-            if(self.promise().continuation)
+            coroutine_handle<> next = self.promise().continuation;
+            detail::finish_sync_wait(self.promise().sync_wait_state);  // the frame may be destroyed from here on
+            if(next)
             {
-              return self.promise().continuation.resume();
+              return next.resume();
             }
           }
 #endif
@@ -228,14 +816,21 @@ namespace awaitables
         return awaiter{};
       }
     };
-    template <class Awaitable, bool suspend_initial, bool use_atomic> struct outcome_promise_type<Awaitable, suspend_initial, use_atomic, true>
+    template <class Awaitable, bool suspend_initial, bool use_atomic> struct outcome_promise_type<Awaitable, suspend_initial, use_atomic, true> : coroutine_frame_allocation
     {
       using container_type = void;
       using result_set_type = std::conditional_t<use_atomic, std::atomic<bool>, fake_atomic<bool>>;
       result_set_type result_set{false};
       coroutine_handle<> continuation;
+      cancellation_token _token;  // passed on to children, as void results cannot be cancelled
+      std::conditional_t<use_atomic, std::atomic<int>, fake_atomic<int>> sync_wait_state{sync_wait_states::running};
 
       outcome_promise_type() {}
+      template <class... Args>
+      explicit outcome_promise_type(const Args &... args) noexcept
+          : _token(detail::find_cancellation_token(args...))
+      {
+      }
       outcome_promise_type(const outcome_promise_type &) = delete;
       outcome_promise_type(outcome_promise_type &&) = delete;
       outcome_promise_type &operator=(const outcome_promise_type &) = delete;
@@ -255,6 +850,14 @@ namespace awaitables
         assert(!result_set.load(std::memory_order_acquire));
         std::rethrow_exception(std::current_exception());  // throws
       }
+      bool _cancellation_requested() const noexcept { return false; }
+      bool _complete_cancelled() noexcept { return false; }
+      template <class U> auto await_transform(U &&v)
+      {
+        inherit_cancellation_token(v, _token);  // ADL finds the overload for awaitable
+        using awaiter_type = decltype(detail::get_awaiter(static_cast<U &&>(v), 0));
+        return detail::cancellable_awaiter<outcome_promise_type, awaiter_type>{this, detail::get_awaiter(static_cast<U &&>(v), 0)};
+      }
       auto initial_suspend() noexcept
       {
         struct awaiter
@@ -274,14 +877,18 @@ namespace awaitables
 #if OUTCOME_HAVE_NOOP_COROUTINE
           coroutine_handle<> await_suspend(coroutine_handle<outcome_promise_type> self) noexcept
           {
-            return self.promise().continuation ? self.promise().continuation : noop_coroutine();
+            coroutine_handle<> next = self.promise().continuation ? self.promise().continuation : noop_coroutine();
+            detail::finish_sync_wait(self.promise().sync_wait_state);  // the frame may be destroyed from here on
+            return next;
           }
 #else
-          void await_suspend(coroutine_handle<outcome_promise_type> self)
+          void await_suspend(coroutine_handle<outcome_promise_type> self) noexcept
           {
-            if(self.promise().continuation)
+            coroutine_handle<> next = self.promise().continuation;
+            detail::finish_sync_wait(self.promise().sync_wait_state);  // the frame may be destroyed from here on
+            if(next)
             {
-              return self.promise().continuation.resume();
+              return next.resume();
             }
           }
 #endif
@@ -338,33 +945,985 @@ namespace awaitables
       coroutine_handle<> await_suspend(coroutine_handle<> cont) noexcept
       {
         _h.promise().continuation = cont;
+        if(suspend_initial && _h.promise()._complete_cancelled())
+        {
+          detail::finish_sync_wait(_h.promise().sync_wait_state);
+          return cont;  // cancelled before it started
+        }
         return _h;
       }
 #else
-      void await_suspend(coroutine_handle<> cont)
+      bool await_suspend(coroutine_handle<> cont)
       {
         _h.promise().continuation = cont;
+        if(suspend_initial && _h.promise()._complete_cancelled())
+        {
+          detail::finish_sync_wait(_h.promise().sync_wait_state);
+          return false;  // cancelled before it started
+        }
         _h.resume();
+        return true;
       }
 #endif
     };
-#endif
-  }  // namespace detail
-
-}  // namespace awaitables
+    template <class Cont, bool use_atomic> inline void inherit_cancellation_token(awaitable<Cont, true, use_atomic> &a, const cancellation_token &t) noexcept
+    {
+      if(a._h && !a._h.promise()._token.can_be_cancelled())
+      {
+        a._h.promise()._token = t;
+      }
+    }
 
-OUTCOME_V2_NAMESPACE_END
+    template <class Cont, bool suspend_initial> inline Cont sync_wait(awaitable<Cont, suspend_initial, true> a)
+    {
+      auto &state = a._h.promise().sync_wait_state;
+      if(state.load(std::memory_order_acquire) != sync_wait_states::finished)
+      {
+        if(suspend_initial)
+        {
+          a._h.resume();  // runs on this thread until it first suspends
+        }
+        detail::wait_until_finished(state);
+      }
+      return a.await_resume();
+    }
 
-#endif
+    template <class Awaitable> class OUTCOME_NODISCARD maybe_ready
+    {
+    public:
+      using container_type = typename Awaitable::container_type;
+      static_assert(!std::is_void<container_type>::value, "maybe_ready needs an awaitable with a value");
 
-#ifdef OUTCOME_FOUND_COROUTINE_HEADER
-OUTCOME_COROUTINE_SUPPORT_NAMESPACE_EXPORT_BEGIN
-/*! AWAITING HUGO JSON CONVERSION TOOL
-SIGNATURE NOT RECOGNISED
-*/
-template <class T> using eager = OUTCOME_V2_NAMESPACE::awaitables::detail::awaitable<T, false, false>;
+    private:
+      template <class A> friend void inherit_cancellation_token(maybe_ready<A> &a, const cancellation_token &t) noexcept;
 
-/*! AWAITING HUGO JSON CONVERSION TOOL
+      union
+      {
+        container_type _value;
+        Awaitable _task;
+      };
+      bool _is_ready;
+
+    public:
+      //! Implicit construction from anything implicitly convertible to a ready value, which creates no coroutine.
+      OUTCOME_TEMPLATE(class U)
+      OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_convertible<U, container_type>::value && !std::is_same<std::decay_t<U>, Awaitable>::value && !std::is_same<std::decay_t<U>, maybe_ready>::value))
+      maybe_ready(U &&v) noexcept(noexcept(container_type(static_cast<U &&>(v))))  // NOLINT
+          : _value(static_cast<U &&>(v))
+          , _is_ready(true)
+      {
+      }
+      //! Implicit construction from a coroutine awaitable.
+      maybe_ready(Awaitable &&t) noexcept  // NOLINT
+          : _task(static_cast<Awaitable &&>(t))
+          , _is_ready(false)
+      {
+      }
+      maybe_ready(maybe_ready &&o) noexcept(std::is_nothrow_move_constructible<container_type>::value)
+          : _is_ready(o._is_ready)
+      {
+        if(_is_ready)
+        {
+          new(&_value) container_type(static_cast<container_type &&>(o._value));
+        }
+        else
+        {
+          new(&_task) Awaitable(static_cast<Awaitable &&>(o._task));
+        }
+      }
+      maybe_ready(const maybe_ready &) = delete;
+      maybe_ready &operator=(maybe_ready &&) = delete;
+      maybe_ready &operator=(const maybe_ready &) = delete;
+      ~maybe_ready()
+      {
+        if(_is_ready)
+        {
+          _value.~container_type();
+        }
+        else
+        {
+          _task.~Awaitable();
+        }
+      }
+
+      //! True if this was constructed from a ready value.
+      bool is_ready_value() const noexcept { return _is_ready; }
+
+      bool await_ready() noexcept { return _is_ready || _task.await_ready(); }
+      auto await_suspend(coroutine_handle<> cont) noexcept(noexcept(_task.await_suspend(cont))) { return _task.await_suspend(cont); }
+      container_type await_resume()
+      {
+        if(_is_ready)
+        {
+          return static_cast<container_type &&>(_value);
+        }
+        return _task.await_resume();
+      }
+    };
+    template <class A> inline void inherit_cancellation_token(maybe_ready<A> &a, const cancellation_token &t) noexcept
+    {
+      if(!a._is_ready)
+      {
+        inherit_cancellation_token(a._task, t);
+      }
+    }
+
+    template <class T, class = decltype(std::declval<const T &>().has_failure())> constexpr inline bool element_has_failure(const T &v, int /*unused*/) noexcept { return v.has_failure(); }
+    template <class T> constexpr inline bool element_has_failure(const T & /*unused*/, ...) noexcept { return false; }
+
+    template <class T> class OUTCOME_NODISCARD generator
+    {
+    public:
+      using value_type = T;
+
+      struct promise_type : coroutine_frame_allocation
+      {
+        union
+        {
+          OUTCOME_V2_NAMESPACE::detail::empty_type _default{};
+          T _slot;  // holds yielded values which are not already a T rvalue
+        };
+        bool _slot_used{false};
+        bool _stop_on_failure{false};
+        T *_current{nullptr};
+
+        promise_type() noexcept {}
+        promise_type(const promise_type &) = delete;
+        promise_type(promise_type &&) = delete;
+        promise_type &operator=(const promise_type &) = delete;
+        promise_type &operator=(promise_type &&) = delete;
+        ~promise_type() { _reset(); }
+
+        void _reset() noexcept
+        {
+          if(_slot_used)
+          {
+            _slot.~T();
+            _slot_used = false;
+          }
+        }
+        // Moves on to the next element, if there is one
+        void _advance()
+        {
+          const bool stop = _stop_on_failure && _current != nullptr && detail::element_has_failure(*_current, 0);
+          _current = nullptr;
+          _reset();
+          auto h = coroutine_handle<promise_type>::from_promise(*this);
+          if(!stop && !h.done())
+          {
+            h.resume();  // could throw
+          }
+        }
+
+        generator get_return_object() noexcept { return generator(coroutine_handle<promise_type>::from_promise(*this)); }
+        suspend_always initial_suspend() noexcept { return {}; }
+        suspend_always final_suspend() noexcept { return {}; }
+        // Yielding a T rvalue refers to it in place until resumed
+        suspend_always yield_value(T &&v) noexcept
+        {
+          _current = std::addressof(v);
+          return {};
+        }
+        OUTCOME_TEMPLATE(class U)
+        OUTCOME_TREQUIRES(OUTCOME_TPRED(OUTCOME_V2_NAMESPACE::detail::is_constructible<T, U>))
+        suspend_always yield_value(U &&v)
+        {
+          new(&_slot) T(static_cast<U &&>(v));  // could throw
+          _slot_used = true;
+          _current = &_slot;
+          return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception()
+        {
+          _reset();
+#ifdef __cpp_exceptions
+          auto e = std::current_exception();
+          auto ec = detail::error_from_exception(static_cast<decltype(e) &&>(e), {});
+          // Try to set error code first, which becomes the final element
+          if(!detail::error_is_set(ec) || !detail::try_set_error(static_cast<decltype(ec) &&>(ec), &_slot))
+          {
+            detail::set_or_rethrow(e, &_slot);  // could throw
+          }
+          _slot_used = true;
+          _current = &_slot;
+#else
+          std::terminate();
+#endif
+        }
+        // Generators cannot suspend except when yielding
+        template <class U> suspend_never await_transform(U &&) = delete;
+      };
+
+      struct sentinel
+      {
+      };
+      class iterator
+      {
+        friend class generator;
+        coroutine_handle<promise_type> _h;
+
+        explicit iterator(coroutine_handle<promise_type> h) noexcept
+            : _h(h)
+        {
+        }
+
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using reference = T &;
+        using pointer = T *;
+
+        iterator() = default;
+        iterator &operator++()
+        {
+          _h.promise()._advance();
+          return *this;
+        }
+        void operator++(int) { ++*this; }
+        //! The current element, which may be moved from.
+        reference operator*() const noexcept { return *_h.promise()._current; }
+        pointer operator->() const noexcept { return _h.promise()._current; }
+        friend bool operator==(const iterator &i, sentinel /*unused*/) noexcept { return !i._h || i._h.promise()._current == nullptr; }
+        friend bool operator!=(const iterator &i, sentinel s) noexcept { return !(i == s); }
+        friend bool operator==(sentinel s, const iterator &i) noexcept { return i == s; }
+        friend bool operator!=(sentinel s, const iterator &i) noexcept { return !(i == s); }
+      };
+
+    private:
+      coroutine_handle<promise_type> _h;
+
+      explicit generator(coroutine_handle<promise_type> h) noexcept
+          : _h(h)
+      {
+      }
+
+    public:
+      generator(generator &&o) noexcept
+          : _h(o._h)
+      {
+        o._h = nullptr;
+      }
+      generator(const generator &) = delete;
+      generator &operator=(generator &&o) noexcept
+      {
+        if(this != &o)
+        {
+          this->~generator();
+          new(this) generator(static_cast<generator &&>(o));
+        }
+        return *this;
+      }
+      generator &operator=(const generator &) = delete;
+      ~generator()
+      {
+        if(_h)
+        {
+          _h.destroy();
+        }
+      }
+
+      //! Ends the sequence after the first element with a failure.
+      generator &stop_on_failure() & noexcept
+      {
+        _h.promise()._stop_on_failure = true;
+        return *this;
+      }
+      //! Ends the sequence after the first element with a failure.
+      generator stop_on_failure() && noexcept
+      {
+        _h.promise()._stop_on_failure = true;
+        return static_cast<generator &&>(*this);
+      }
+
+      //! Runs the generator until it yields its first element. Can only be called once.
+      iterator begin()
+      {
+        if(_h)
+        {
+          _h.promise()._advance();
+        }
+        return iterator(_h);
+      }
+      sentinel end() const noexcept { return {}; }
+    };
+
+#if OUTCOME_HAVE_NOOP_COROUTINE
+    template <class T> struct is_lazy_awaitable : std::false_type
+    {
+    };
+    template <class Cont, bool use_atomic> struct is_lazy_awaitable<awaitable<Cont, true, use_atomic>> : std::true_type
+    {
+    };
+
+    /* Shared between a when_all() or when_any() awaiter and the children it has started,
+    so children still running after the operation settles can finish detached. when_all()
+    settles on the first failure or the last success, when_any() on the first success or
+    the last failure.
+    */
+    class when_control
+    {
+    public:
+      enum status_type : int
+      {
+        pending,    // not started, owned by the awaiter
+        running,    // started, owned by the awaiter
+        finished,   // completed, owned by the awaiter
+        cancelled,  // never to be started, owned by the awaiter
+        detached    // started, destroys itself on completion
+      };
+      static constexpr size_t npos = static_cast<size_t>(-1);
+
+    private:
+      std::atomic<size_t> _refs{1}, _remaining;
+      std::atomic<bool> _settled{false};
+      std::atomic<unsigned> _arrivals{0};
+      size_t _count;
+      bool _any;
+      bool _decisive{false};
+      size_t _settled_index{npos};
+      coroutine_handle<> _continuation;
+
+      when_control(size_t count, bool any) noexcept
+          : _remaining(count)
+          , _count(count)
+          , _any(any)
+      {
+        for(size_t n = 0; n < count; n++)
+        {
+          new(&status(n)) std::atomic<int>(pending);
+        }
+      }
+      static constexpr size_t _bytes(size_t count) noexcept { return sizeof(when_control) + count * sizeof(std::atomic<int>); }
+      // The awaiter and the child which settles the operation both arrive, the second resumes the awaiter
+      coroutine_handle<> _arrive() noexcept { return (_arrivals.fetch_add(1, std::memory_order_acq_rel) == 1) ? _continuation : noop_coroutine(); }
+
+    public:
+      when_control(const when_control &) = delete;
+      when_control &operator=(const when_control &) = delete;
+
+      static when_control *create(size_t count, bool any) { return new(coroutine_frame_pool::allocate(_bytes(count))) when_control(count, any); }
+      void release() noexcept
+      {
+        if(_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+          const size_t bytes = _bytes(_count);
+          this->~when_control();
+          coroutine_frame_pool::deallocate(this, bytes);
+        }
+      }
+      // The status of each child follows the control block, so detached children can outlive the awaiter
+      std::atomic<int> &status(size_t n) noexcept { return reinterpret_cast<std::atomic<int> *>(this + 1)[n]; }
+      // Stop children completing later from looking at the awaiter
+      void abandon() noexcept { _settled.store(true, std::memory_order_release); }
+      // Whether child `n` is now detached, and so will destroy itself when it completes
+      bool disown(size_t n) noexcept
+      {
+        int expected = running;
+        return status(n).compare_exchange_strong(expected, detached, std::memory_order_acq_rel) || expected == detached;
+      }
+      // The child which settled the operation, and whether it did so before all children completed
+      size_t settled_index() const noexcept { return _settled_index; }
+      bool decisive() const noexcept { return _decisive; }
+
+      // Starts the children until the operation settles, returning whether the awaiter should suspend
+      bool start(coroutine_handle<> continuation, const coroutine_handle<> *children) noexcept
+      {
+        _continuation = continuation;
+        for(size_t n = 0; n < _count && !_settled.load(std::memory_order_acquire); n++)
+        {
+          int expected = pending;
+          if(status(n).compare_exchange_strong(expected, running, std::memory_order_acq_rel))
+          {
+            _refs.fetch_add(1, std::memory_order_relaxed);
+            children[n].resume();
+          }
+        }
+        return _arrivals.fetch_add(1, std::memory_order_acq_rel) != 1;
+      }
+      // Called by each child as it completes, returning the coroutine to resume next
+      coroutine_handle<> complete(size_t index, bool failed) noexcept
+      {
+        if(failed != _any)
+        {
+          if(_settled.exchange(true, std::memory_order_acq_rel))
+          {
+            return noop_coroutine();
+          }
+          _decisive = true;
+          _settled_index = index;
+          for(size_t n = 0; n < _count; n++)
+          {
+            int expected = pending;
+            if(n != index && !status(n).compare_exchange_strong(expected, cancelled, std::memory_order_acq_rel))
+            {
+              expected = running;
+              status(n).compare_exchange_strong(expected, detached, std::memory_order_acq_rel);
+            }
+          }
+          return _arrive();
+        }
+        if(_remaining.fetch_sub(1, std::memory_order_acq_rel) != 1 || _settled.exchange(true, std::memory_order_acq_rel))
+        {
+          return noop_coroutine();
+        }
+        _settled_index = index;
+        return _arrive();
+      }
+    };
+
+    template <class Awaitable> struct when_child_awaiter
+    {
+      Awaitable &child;
+
+      bool await_ready() noexcept { return child.await_ready(); }
+      coroutine_handle<> await_suspend(coroutine_handle<> cont) noexcept { return child.await_suspend(cont); }
+      void await_resume() noexcept {}  // leaves the result in the child
+    };
+    // A coroutine which owns a child of when_all(), and reports its completion
+    template <class Awaitable> class OUTCOME_NODISCARD when_child
+    {
+    public:
+      struct promise_type : coroutine_frame_allocation
+      {
+        Awaitable *child;
+        when_control *control{nullptr};
+        size_t index{0};
+
+        explicit promise_type(Awaitable &c) noexcept
+            : child(&c)
+        {
+        }
+        when_child get_return_object() noexcept { return when_child(coroutine_handle<promise_type>::from_promise(*this)); }
+        suspend_always initial_suspend() noexcept { return {}; }
+        auto final_suspend() noexcept
+        {
+          struct awaiter
+          {
+            bool await_ready() noexcept { return false; }
+            void await_resume() noexcept {}
+            coroutine_handle<> await_suspend(coroutine_handle<promise_type> self) noexcept
+            {
+              auto &p = self.promise();
+              when_control *control = p.control;
+              const size_t index = p.index;
+              const bool failed = !p.child->_h.promise().result.has_value();
+              int expected = when_control::running;
+              if(!control->status(index).compare_exchange_strong(expected, when_control::finished, std::memory_order_acq_rel))
+              {
+                // Detached by the failure of a sibling, so nothing else owns this
+                self.destroy();
+                control->release();
+                return noop_coroutine();
+              }
+              // From here on the awaiter may destroy this frame at any time
+              coroutine_handle<> next = control->complete(index, failed);
+              control->release();
+              return next;
+            }
+          };
+          return awaiter{};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+      };
+
+    private:
+      coroutine_handle<promise_type> _h;
+
+      explicit when_child(coroutine_handle<promise_type> h) noexcept
+          : _h(h)
+      {
+      }
+
+    public:
+      when_child(when_child &&o) noexcept
+          : _h(o._h)
+      {
+        o._h = nullptr;
+      }
+      when_child(const when_child &) = delete;
+      when_child &operator=(when_child &&) = delete;
+      when_child &operator=(const when_child &) = delete;
+      ~when_child()
+      {
+        if(_h)
+        {
+          _h.destroy();
+        }
+      }
+
+      coroutine_handle<> handle() const noexcept { return _h; }
+      typename Awaitable::container_type &result() const noexcept { return _h.promise().child->_h.promise().result; }
+      void attach(when_control *control, size_t index) noexcept
+      {
+        _h.promise().control = control;
+        _h.promise().index = index;
+      }
+      // Gives up ownership of a child which will destroy itself
+      void release() noexcept { _h = nullptr; }
+    };
+    template <class Awaitable> inline when_child<Awaitable> make_when_child(Awaitable child) { co_await when_child_awaiter<Awaitable>{child}; }
+
+    // Rebinds the value type of a result or outcome, including in its no-value policy if that is templated on it
+    template <class Cont, class T> struct rebind_value
+    {
+      using type = typename Cont::template rebind<T>;
+    };
+    template <class R, class S, template <class, class, class> class NoValuePolicy, class X, class T> struct rebind_value<OUTCOME_V2_NAMESPACE::basic_result<R, S, NoValuePolicy<R, S, X>>, T>
+    {
+      using type = OUTCOME_V2_NAMESPACE::basic_result<T, S, NoValuePolicy<T, S, X>>;
+    };
+    template <class R, class S, class P, template <class, class, class> class NoValuePolicy, class T> struct rebind_value<OUTCOME_V2_NAMESPACE::basic_outcome<R, S, P, NoValuePolicy<R, S, P>>, T>
+    {
+      using type = OUTCOME_V2_NAMESPACE::basic_outcome<T, S, P, NoValuePolicy<T, S, P>>;
+    };
+
+    template <class Cont> using when_all_value_type = std::conditional_t<std::is_void<typename Cont::value_type>::value, OUTCOME_V2_NAMESPACE::success_type<void>, typename Cont::value_type>;
+    template <class Cont> inline typename Cont::value_type &&when_all_value(Cont &c, std::false_type /*is_void*/) noexcept { return static_cast<Cont &&>(c).assume_value(); }
+    template <class Cont> inline OUTCOME_V2_NAMESPACE::success_type<void> when_all_value(Cont & /*unused*/, std::true_type /*is_void*/) noexcept { return {}; }
+
+    // Owns the children of a when_all() or when_any() awaiter
+    template <class... Awaitables> class when_children
+    {
+    protected:
+      static constexpr size_t _count = sizeof...(Awaitables);
+
+      std::tuple<when_child<Awaitables>...> _children;
+      when_control *_control{nullptr};
+
+      template <size_t... I> bool _start(coroutine_handle<> cont, bool any, std::index_sequence<I...> /*unused*/)
+      {
+        _control = when_control::create(_count, any);
+        const coroutine_handle<> handles[_count] = {std::get<I>(_children).handle()...};
+        (void) std::initializer_list<int>{(std::get<I>(_children).attach(_control, I), 0)...};
+        return _control->start(cont, handles);
+      }
+      template <size_t... I> void _disown(std::index_sequence<I...> /*unused*/) noexcept
+      {
+        (void) std::initializer_list<int>{(_control->disown(I) ? std::get<I>(_children).release() : void(), 0)...};
+      }
+
+    public:
+      explicit when_children(Awaitables &&... children)
+          : _children(detail::make_when_child(static_cast<Awaitables &&>(children))...)
+      {
+      }
+      when_children(when_children &&) = delete;
+      when_children(const when_children &) = delete;
+      when_children &operator=(when_children &&) = delete;
+      when_children &operator=(const when_children &) = delete;
+      ~when_children()
+      {
+        if(_control != nullptr)
+        {
+          _control->abandon();
+          _disown(std::index_sequence_for<Awaitables...>());
+          _control->release();
+        }
+      }
+    };
+    template <class Awaitable> class when_range_children
+    {
+    protected:
+      using _container_type = typename Awaitable::container_type;
+
+      std::vector<when_child<Awaitable>> _children;
+      when_control *_control{nullptr};
+
+      bool _start(coroutine_handle<> cont, bool any)
+      {
+        std::vector<coroutine_handle<>> handles;
+        handles.reserve(_children.size());
+        for(auto &child : _children)
+        {
+          handles.push_back(child.handle());
+        }
+        _control = when_control::create(_children.size(), any);
+        for(size_t n = 0; n < _children.size(); n++)
+        {
+          _children[n].attach(_control, n);
+        }
+        return _control->start(cont, handles.data());
+      }
+
+    public:
+      template <class Range> explicit when_range_children(Range &&children)
+      {
+        for(auto &child : children)
+        {
+          _children.push_back(detail::make_when_child(static_cast<Awaitable &&>(child)));
+        }
+      }
+      when_range_children(when_range_children &&) = delete;
+      when_range_children(const when_range_children &) = delete;
+      when_range_children &operator=(when_range_children &&) = delete;
+      when_range_children &operator=(const when_range_children &) = delete;
+      ~when_range_children()
+      {
+        if(_control != nullptr)
+        {
+          _control->abandon();
+          for(size_t n = 0; n < _children.size(); n++)
+          {
+            if(_control->disown(n))
+            {
+              _children[n].release();
+            }
+          }
+          _control->release();
+        }
+      }
+    };
+
+    template <class Result, class... Awaitables> class OUTCOME_NODISCARD when_all_awaitable : public when_children<Awaitables...>
+    {
+      using _base = when_children<Awaitables...>;
+
+      Result _failure(std::integral_constant<size_t, _base::_count> /*unused*/, size_t /*unused*/) noexcept { std::terminate(); }
+      template <size_t I> Result _failure(std::integral_constant<size_t, I> /*unused*/, size_t index)
+      {
+        if(I == index)
+        {
+          using container_type = typename std::tuple_element_t<I, std::tuple<Awaitables...>>::container_type;
+          return Result(static_cast<container_type &&>(std::get<I>(this->_children).result()).as_failure());
+        }
+        return _failure(std::integral_constant<size_t, I + 1>(), index);
+      }
+      template <size_t... I> Result _success(std::index_sequence<I...> /*unused*/)
+      {
+        return Result(OUTCOME_V2_NAMESPACE::in_place_type<typename Result::value_type>,
+                      detail::when_all_value(std::get<I>(this->_children).result(), std::is_void<typename Awaitables::container_type::value_type>())...);
+      }
+
+    public:
+      using _base::_base;
+
+      bool await_ready() noexcept { return _base::_count == 0; }
+      bool await_suspend(coroutine_handle<> cont) { return this->_start(cont, false, std::index_sequence_for<Awaitables...>()); }
+      Result await_resume()
+      {
+        if(this->_control != nullptr && this->_control->decisive())
+        {
+          return _failure(std::integral_constant<size_t, 0>(), this->_control->settled_index());
+        }
+        return _success(std::index_sequence_for<Awaitables...>());
+      }
+    };
+    template <class Result, class Awaitable> class OUTCOME_NODISCARD when_all_range_awaitable : public when_range_children<Awaitable>
+    {
+      using _base = when_range_children<Awaitable>;
+      using _container_type = typename _base::_container_type;
+
+      Result _success(std::false_type /*is_void*/)
+      {
+        typename Result::value_type ret;
+        ret.reserve(this->_children.size());
+        for(auto &child : this->_children)
+        {
+          ret.push_back(static_cast<_container_type &&>(child.result()).assume_value());
+        }
+        return Result(static_cast<typename Result::value_type &&>(ret));
+      }
+      Result _success(std::true_type /*is_void*/) { return Result(OUTCOME_V2_NAMESPACE::success()); }
+
+    public:
+      using _base::_base;
+
+      bool await_ready() noexcept { return this->_children.empty(); }
+      bool await_suspend(coroutine_handle<> cont) { return this->_start(cont, false); }
+      Result await_resume()
+      {
+        if(this->_control != nullptr && this->_control->decisive())
+        {
+          return Result(static_cast<_container_type &&>(this->_children[this->_control->settled_index()].result()).as_failure());
+        }
+        return _success(std::is_void<typename _container_type::value_type>());
+      }
+    };
+
+    template <class Result, class... Awaitables> class OUTCOME_NODISCARD when_any_awaitable : public when_children<Awaitables...>
+    {
+      using _base = when_children<Awaitables...>;
+
+      template <size_t... I> Result _settled(std::index_sequence<I...> /*unused*/)
+      {
+        Result *results[] = {&std::get<I>(this->_children).result()...};
+        return static_cast<Result &&>(*results[this->_control->settled_index()]);
+      }
+
+    public:
+      using _base::_base;
+
+      bool await_ready() noexcept { return false; }
+      bool await_suspend(coroutine_handle<> cont) { return this->_start(cont, true, std::index_sequence_for<Awaitables...>()); }
+      Result await_resume() { return _settled(std::index_sequence_for<Awaitables...>()); }
+    };
+    template <class Result, class Awaitable> class OUTCOME_NODISCARD when_any_range_awaitable : public when_range_children<Awaitable>
+    {
+      using _base = when_range_children<Awaitable>;
+
+    public:
+      using _base::_base;
+
+      bool await_ready() noexcept { return false; }
+      bool await_suspend(coroutine_handle<> cont)
+      {
+        if(this->_children.empty())
+        {
+          std::terminate();  // there is nothing to return
+        }
+        return this->_start(cont, true);
+      }
+      Result await_resume() { return static_cast<Result &&>(this->_children[this->_control->settled_index()].result()); }
+    };
+
+    template <class Range> using when_range_element = std::decay_t<decltype(*std::begin(std::declval<Range &>()))>;
+    template <class Awaitable>
+    using when_all_range_result = typename rebind_value<typename Awaitable::container_type, std::conditional_t<std::is_void<typename Awaitable::container_type::value_type>::value, void, std::vector<typename Awaitable::container_type::value_type>>>::type;
+
+    template <bool... v> struct when_all_of : std::is_same<when_all_of<true, v...>, when_all_of<v..., true>>
+    {
+    };
+    template <class... Awaitables, std::enable_if_t<sizeof...(Awaitables) != 0 && when_all_of<is_lazy_awaitable<Awaitables>::value...>::value, bool> = true>
+    inline auto when_all(Awaitables... children)
+    {
+      using first_container_type = typename std::tuple_element_t<0, std::tuple<Awaitables...>>::container_type;
+      using result_type = typename rebind_value<first_container_type, std::tuple<when_all_value_type<typename Awaitables::container_type>...>>::type;
+      return when_all_awaitable<result_type, Awaitables...>(static_cast<Awaitables &&>(children)...);
+    }
+    template <class Range, std::enable_if_t<!is_lazy_awaitable<Range>::value && is_lazy_awaitable<when_range_element<Range>>::value, bool> = true> inline auto when_all(Range children)
+    {
+      using awaitable_type = when_range_element<Range>;
+      return when_all_range_awaitable<when_all_range_result<awaitable_type>, awaitable_type>(children);
+    }
+    template <class... Awaitables, std::enable_if_t<sizeof...(Awaitables) != 0 && when_all_of<is_lazy_awaitable<Awaitables>::value...>::value, bool> = true>
+    inline auto when_any(Awaitables... children)
+    {
+      using result_type = typename std::tuple_element_t<0, std::tuple<Awaitables...>>::container_type;
+      static_assert(when_all_of<std::is_same<typename Awaitables::container_type, result_type>::value...>::value, "when_any() needs children which all return the same type");
+      return when_any_awaitable<result_type, Awaitables...>(static_cast<Awaitables &&>(children)...);
+    }
+    template <class Range, std::enable_if_t<!is_lazy_awaitable<Range>::value && is_lazy_awaitable<when_range_element<Range>>::value, bool> = true> inline auto when_any(Range children)
+    {
+      using awaitable_type = when_range_element<Range>;
+      return when_any_range_awaitable<typename awaitable_type::container_type, awaitable_type>(children);
+    }
+
+    // A coroutine awaiting a shared_lazy, linked into the list of waiters by its awaiter
+    struct shared_waiter
+    {
+      coroutine_handle<> handle;
+      shared_waiter *next{nullptr};
+    };
+    /* The promise of a shared_lazy, reference counted by its copies. `state` is the promise
+    itself until the first await starts the coroutine, then the intrusive list of waiters,
+    and finally `completed_state()`.
+    */
+    struct shared_promise_base : coroutine_frame_allocation
+    {
+      std::atomic<size_t> refs{1};
+      std::atomic<void *> state;
+
+      shared_promise_base() noexcept
+          : state(this)
+      {
+      }
+      shared_promise_base(const shared_promise_base &) = delete;
+      shared_promise_base &operator=(const shared_promise_base &) = delete;
+
+      void *not_started() noexcept { return this; }
+
+      suspend_always initial_suspend() noexcept { return {}; }
+      auto final_suspend() noexcept
+      {
+        struct awaiter
+        {
+          shared_promise_base *self;
+          bool await_ready() noexcept { return false; }
+          void await_resume() noexcept {}
+          coroutine_handle<> await_suspend(coroutine_handle<> /*unused*/) noexcept
+          {
+            // The last reference may be dropped by any waiter, so the frame is not touched after this
+            auto *w = static_cast<shared_waiter *>(self->state.exchange(completed_state(), std::memory_order_acq_rel));
+            if(w == nullptr)
+            {
+              return noop_coroutine();
+            }
+            while(w->next != nullptr)
+            {
+              shared_waiter *next = w->next;
+              w->handle.resume();
+              w = next;
+            }
+            return w->handle;
+          }
+        };
+        return awaiter{this};
+      }
+    };
+    template <class Cont> class shared_awaitable;
+    template <class Cont> struct shared_promise : shared_promise_base
+    {
+      union
+      {
+        OUTCOME_V2_NAMESPACE::detail::empty_type _default{};
+        Cont result;
+      };
+      bool result_set{false};
+
+      shared_promise() noexcept {}
+      ~shared_promise()
+      {
+        if(result_set)
+        {
+          result.~Cont();
+        }
+      }
+      shared_awaitable<Cont> get_return_object() noexcept { return shared_awaitable<Cont>(*this); }
+      void return_value(Cont &&value)
+      {
+        new(&result) Cont(static_cast<Cont &&>(value));  // could throw
+        result_set = true;
+      }
+      void return_value(const Cont &value)
+      {
+        new(&result) Cont(value);  // could throw
+        result_set = true;
+      }
+      void unhandled_exception()
+      {
+#ifdef __cpp_exceptions
+        auto e = std::current_exception();
+        auto ec = detail::error_from_exception(static_cast<decltype(e) &&>(e), {});
+        // Try to set error code first
+        if(!detail::error_is_set(ec) || !detail::try_set_error(static_cast<decltype(ec) &&>(ec), &result))
+        {
+          detail::set_or_rethrow(e, &result);  // could throw
+        }
+        result_set = true;
+#else
+        std::terminate();
+#endif
+      }
+      const Cont &get() const noexcept { return result; }
+    };
+    template <> struct shared_promise<void> : shared_promise_base
+    {
+      inline shared_awaitable<void> get_return_object() noexcept;
+      void return_void() noexcept {}
+      void unhandled_exception() { std::rethrow_exception(std::current_exception()); }  // throws
+      void get() const noexcept {}
+    };
+
+    template <class Cont> class OUTCOME_NODISCARD shared_awaitable
+    {
+    public:
+      using container_type = Cont;
+      using promise_type = shared_promise<Cont>;
+
+    private:
+      promise_type *_p{nullptr};
+
+      void _release() noexcept
+      {
+        if(_p != nullptr && _p->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+          coroutine_handle<promise_type>::from_promise(*_p).destroy();
+        }
+        _p = nullptr;
+      }
+
+    public:
+      explicit shared_awaitable(promise_type &p) noexcept
+          : _p(&p)
+      {
+      }
+      //! Default constructor, refers to no computation.
+      shared_awaitable() = default;
+      shared_awaitable(const shared_awaitable &o) noexcept
+          : _p(o._p)
+      {
+        if(_p != nullptr)
+        {
+          _p->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+      shared_awaitable(shared_awaitable &&o) noexcept
+          : _p(o._p)
+      {
+        o._p = nullptr;
+      }
+      shared_awaitable &operator=(const shared_awaitable &o) noexcept
+      {
+        shared_awaitable temp(o);
+        std::swap(_p, temp._p);
+        return *this;
+      }
+      shared_awaitable &operator=(shared_awaitable &&o) noexcept
+      {
+        std::swap(_p, o._p);
+        return *this;
+      }
+      ~shared_awaitable() { _release(); }
+
+      //! True if this refers to a computation.
+      explicit operator bool() const noexcept { return _p != nullptr; }
+      //! True if the computation has completed.
+      bool is_ready() const noexcept { return _p != nullptr && _p->state.load(std::memory_order_acquire) == completed_state(); }
+
+      struct awaiter : shared_waiter
+      {
+        promise_type *p;
+
+        explicit awaiter(promise_type *_p) noexcept
+            : p(_p)
+        {
+        }
+        bool await_ready() noexcept { return p->state.load(std::memory_order_acquire) == completed_state(); }
+        coroutine_handle<> await_suspend(coroutine_handle<> h) noexcept
+        {
+          this->handle = h;
+          void *old = p->state.load(std::memory_order_acquire);
+          do
+          {
+            if(old == completed_state())
+            {
+              return h;
+            }
+            this->next = (old == p->not_started()) ? nullptr : static_cast<shared_waiter *>(old);
+          } while(!p->state.compare_exchange_weak(old, static_cast<shared_waiter *>(this), std::memory_order_acq_rel, std::memory_order_acquire));
+          if(old == p->not_started())
+          {
+            return coroutine_handle<promise_type>::from_promise(*p);  // the first waiter starts it
+          }
+          return noop_coroutine();
+        }
+        //! The result, which lives as long as the shared_lazy it was awaited from.
+        decltype(auto) await_resume() const noexcept { return p->get(); }
+      };
+      awaiter operator co_await() const noexcept { return awaiter(_p); }
+    };
+    inline shared_awaitable<void> shared_promise<void>::get_return_object() noexcept { return shared_awaitable<void>(*this); }
+#endif
+#endif
+  }  // namespace detail
+
+}  // namespace awaitables
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
+
+#ifdef OUTCOME_FOUND_COROUTINE_HEADER
+OUTCOME_COROUTINE_SUPPORT_NAMESPACE_EXPORT_BEGIN
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T> using eager = OUTCOME_V2_NAMESPACE::awaitables::detail::awaitable<T, false, false>;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
 template <class T> using atomic_eager = OUTCOME_V2_NAMESPACE::awaitables::detail::awaitable<T, false, true>;
@@ -379,5 +1938,47 @@ SIGNATURE NOT RECOGNISED
 */
 template <class T> using atomic_lazy = OUTCOME_V2_NAMESPACE::awaitables::detail::awaitable<T, true, true>;
 
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Awaitable> using maybe_ready = OUTCOME_V2_NAMESPACE::awaitables::detail::maybe_ready<Awaitable>;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T> using generator = OUTCOME_V2_NAMESPACE::awaitables::detail::generator<T>;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  cancellation_source. Potential doc page: `cancellation_source`
+*/
+using OUTCOME_V2_NAMESPACE::awaitables::detail::cancellation_source;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  cancellation_token. Potential doc page: `cancellation_token`
+*/
+using OUTCOME_V2_NAMESPACE::awaitables::detail::cancellation_token;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+using OUTCOME_V2_NAMESPACE::awaitables::detail::sync_wait;
+
+#if OUTCOME_HAVE_NOOP_COROUTINE
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+using OUTCOME_V2_NAMESPACE::awaitables::detail::when_all;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+using OUTCOME_V2_NAMESPACE::awaitables::detail::when_any;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T> using shared_lazy = OUTCOME_V2_NAMESPACE::awaitables::detail::shared_awaitable<T>;
+#endif
+
 OUTCOME_COROUTINE_SUPPORT_NAMESPACE_END
 #endif
@@ -28,11 +28,26 @@ Distributed under the Boost Software License, Version 1.0.
 #include "../config.hpp"
 
 #include <cassert>
+#include <cstring>  // for memcpy
 
 OUTCOME_V2_NAMESPACE_BEGIN
 
 namespace detail
 {
+  // Moves the bytes of src into dest, ending the lifetime of src. Only valid for trivially relocatable types.
+  template <class T> inline void relocate(T *dest, T *src) noexcept
+  {
+    memcpy(static_cast<void *>(dest), static_cast<const void *>(src), sizeof(T));  // NOLINT
+  }
+  // Swaps the bytes of a and b. Only valid for trivially relocatable types.
+  template <class T> inline void relocating_swap(T &a, T &b) noexcept
+  {
+    alignas(T) unsigned char temp[sizeof(T)];
+    memcpy(temp, static_cast<const void *>(&a), sizeof(T));                          // NOLINT
+    memcpy(static_cast<void *>(&a), static_cast<const void *>(&b), sizeof(T));      // NOLINT
+    memcpy(static_cast<void *>(&b), temp, sizeof(T));                               // NOLINT
+  }
+
   template <class T, bool nothrow> struct strong_swap_impl
   {
     constexpr strong_swap_impl(bool &allgood, T &a, T &b)
@@ -186,7 +201,11 @@ namespace detail
   but it make clang's optimiser do the right thing, so it's worth it.
   */
 #define OUTCOME_USE_CONSTEXPR_ENUM_STATUS 0
+#if OUTCOME_ENABLE_COMPACT_STATUS
+  enum class status : uint8_t
+#else
   enum class status : uint16_t
+#endif
   {
     // WARNING: These bits are not tracked by abi-dumper, but changing them will break ABI!
     none = 0,
@@ -217,18 +236,27 @@ namespace detail
   struct status_bitfield_type
   {
     status status_value{status::none};
+#if !OUTCOME_ENABLE_COMPACT_STATUS
     uint16_t spare_storage_value{0};  // hooks::spare_storage()
+#endif
 
     constexpr status_bitfield_type() = default;
     constexpr status_bitfield_type(status v) noexcept
         : status_value(v)
     {
     }  // NOLINT
+#if OUTCOME_ENABLE_COMPACT_STATUS
+    constexpr status_bitfield_type(status v, uint16_t /*unused*/) noexcept
+        : status_value(v)
+    {
+    }
+#else
     constexpr status_bitfield_type(status v, uint16_t s) noexcept
         : status_value(v)
         , spare_storage_value(s)
     {
     }
+#endif
     constexpr status_bitfield_type(const status_bitfield_type &) = default;
     constexpr status_bitfield_type(status_bitfield_type &&) = default;
     constexpr status_bitfield_type &operator=(const status_bitfield_type &) = default;
@@ -757,7 +785,11 @@ namespace detail
   };
 #if !defined(NDEBUG)
   // Check is trivial in all ways except default constructibility
+#if OUTCOME_ENABLE_COMPACT_STATUS
+  static_assert(sizeof(status_bitfield_type) == 1, "status_bitfield_type is not sized 1 byte!");
+#else
   static_assert(sizeof(status_bitfield_type) == 4, "status_bitfield_type is not sized 4 bytes!");
+#endif
   static_assert(std::is_trivially_copyable<status_bitfield_type>::value, "status_bitfield_type is not trivially copyable!");
   static_assert(std::is_trivially_assignable<status_bitfield_type, status_bitfield_type>::value, "status_bitfield_type is not trivially assignable!");
   static_assert(std::is_trivially_destructible<status_bitfield_type>::value, "status_bitfield_type is not trivially destructible!");
@@ -937,6 +969,17 @@ namespace detail
     }
   };
 
+  /* Used if both T and E are trivial, and the storage fits into two registers, but is not
+  a multiple of a register in size. Padding it out lets the compiler treat it as one or two
+  64 bit integers, rather than spilling it to the stack to get at the fields.
+  */
+  template <class T, class E> struct alignas(8) value_storage_packed : value_storage_trivial<T, E>
+  {
+    using value_storage_trivial<T, E>::value_storage_trivial;
+    using value_type = T;
+    using error_type = E;
+  };
+
   // Used if T is non-trivial
   template <class T, class E> struct value_storage_nontrivial
   {
@@ -1182,6 +1225,12 @@ namespace detail
     swap(value_storage_nontrivial &o) noexcept(detail::is_nothrow_swappable<_value_type_>::value &&detail::is_nothrow_swappable<_error_type_>::value)
     {
       using std::swap;
+      // If both alternatives are trivially relocatable, whatever the states we can simply swap bytes
+      if(trait::is_trivially_relocatable<_value_type_>::value && trait::is_trivially_relocatable<_error_type_>::value)
+      {
+        relocating_swap(*this, o);
+        return;
+      }
       // empty/empty
       if(!_status.have_value() && !o._status.have_value() && !_status.have_error() && !o._status.have_error())
       {
@@ -1234,10 +1283,17 @@ namespace detail
       if(_status.have_value() && !o._status.have_error())
       {
         // Move construct me into other
-        new(&o._value) _value_type_(static_cast<_value_type_ &&>(_value));  // NOLINT
-        if(!trait::is_move_bitcopying<value_type>::value)
+        if(trait::is_trivially_relocatable<_value_type_>::value)
         {
-          this->_value.~value_type();  // NOLINT
+          relocate(&o._value, &_value);
+        }
+        else
+        {
+          new(&o._value) _value_type_(static_cast<_value_type_ &&>(_value));  // NOLINT
+          if(!trait::is_move_bitcopying<value_type>::value)
+          {
+            this->_value.~value_type();  // NOLINT
+          }
         }
         swap(_status, o._status);
         return;
@@ -1245,10 +1301,17 @@ namespace detail
       if(o._status.have_value() && !_status.have_error())
       {
         // Move construct other into me
-        new(&_value) _value_type_(static_cast<_value_type_ &&>(o._value));  // NOLINT
-        if(!trait::is_move_bitcopying<value_type>::value)
+        if(trait::is_trivially_relocatable<_value_type_>::value)
         {
-          o._value.~value_type();  // NOLINT
+          relocate(&_value, &o._value);
+        }
+        else
+        {
+          new(&_value) _value_type_(static_cast<_value_type_ &&>(o._value));  // NOLINT
+          if(!trait::is_move_bitcopying<value_type>::value)
+          {
+            o._value.~value_type();  // NOLINT
+          }
         }
         swap(_status, o._status);
         return;
@@ -1256,10 +1319,17 @@ namespace detail
       if(_status.have_error() && !o._status.have_value())
       {
         // Move construct me into other
-        new(&o._error) _error_type_(static_cast<_error_type_ &&>(_error));  // NOLINT
-        if(!trait::is_move_bitcopying<error_type>::value)
+        if(trait::is_trivially_relocatable<_error_type_>::value)
         {
-          this->_error.~error_type();  // NOLINT
+          relocate(&o._error, &_error);
+        }
+        else
+        {
+          new(&o._error) _error_type_(static_cast<_error_type_ &&>(_error));  // NOLINT
+          if(!trait::is_move_bitcopying<error_type>::value)
+          {
+            this->_error.~error_type();  // NOLINT
+          }
         }
         swap(_status, o._status);
         return;
@@ -1267,10 +1337,17 @@ namespace detail
       if(o._status.have_error() && !_status.have_value())
       {
         // Move construct other into me
-        new(&_error) _error_type_(static_cast<_error_type_ &&>(o._error));  // NOLINT
-        if(!trait::is_move_bitcopying<error_type>::value)
+        if(trait::is_trivially_relocatable<_error_type_>::value)
         {
-          o._error.~error_type();  // NOLINT
+          relocate(&_error, &o._error);
+        }
+        else
+        {
+          new(&_error) _error_type_(static_cast<_error_type_ &&>(o._error));  // NOLINT
+          if(!trait::is_move_bitcopying<error_type>::value)
+          {
+            o._error.~error_type();  // NOLINT
+          }
         }
         swap(_status, o._status);
         return;
@@ -1390,7 +1467,7 @@ namespace detail
       }
       if(this->_status.have_value() && !o._status.have_value() && !o._status.have_error())
       {
-        if(!trait::is_move_bitcopying<value_type>::value || this->_status.have_moved_from())
+        if(!trait::is_move_bitcopying<value_type>::value || !this->_status.have_moved_from())
         {
           this->_value.~_value_type_();  // NOLINT
         }
@@ -1407,7 +1484,7 @@ namespace detail
       }
       if(this->_status.have_error() && !o._status.have_value() && !o._status.have_error())
       {
-        if(!trait::is_move_bitcopying<error_type>::value || this->_status.have_moved_from())
+        if(!trait::is_move_bitcopying<error_type>::value || !this->_status.have_moved_from())
         {
           this->_error.~_error_type_();  // NOLINT
         }
@@ -1424,7 +1501,7 @@ namespace detail
       }
       if(this->_status.have_value() && o._status.have_error())
       {
-        if(!trait::is_move_bitcopying<value_type>::value || this->_status.have_moved_from())
+        if(!trait::is_move_bitcopying<value_type>::value || !this->_status.have_moved_from())
         {
           this->_value.~_value_type_();  // NOLINT
         }
@@ -1435,7 +1512,7 @@ namespace detail
       }
       if(this->_status.have_error() && o._status.have_value())
       {
-        if(!trait::is_move_bitcopying<error_type>::value || this->_status.have_moved_from())
+        if(!trait::is_move_bitcopying<error_type>::value || !this->_status.have_moved_from())
         {
           this->_error.~_error_type_();  // NOLINT
         }
@@ -1482,7 +1559,7 @@ namespace detail
       }
       if(this->_status.have_value() && !o._status.have_value() && !o._status.have_error())
       {
-        if(!trait::is_move_bitcopying<value_type>::value || this->_status.have_moved_from())
+        if(!trait::is_move_bitcopying<value_type>::value || !this->_status.have_moved_from())
         {
           this->_value.~_value_type_();  // NOLINT
         }
@@ -1497,7 +1574,7 @@ namespace detail
       }
       if(this->_status.have_error() && !o._status.have_value() && !o._status.have_error())
       {
-        if(!trait::is_move_bitcopying<error_type>::value || this->_status.have_moved_from())
+        if(!trait::is_move_bitcopying<error_type>::value || !this->_status.have_moved_from())
         {
           this->_error.~_error_type_();  // NOLINT
         }
@@ -1512,7 +1589,7 @@ namespace detail
       }
       if(this->_status.have_value() && o._status.have_error())
       {
-        if(!trait::is_move_bitcopying<value_type>::value || this->_status.have_moved_from())
+        if(!trait::is_move_bitcopying<value_type>::value || !this->_status.have_moved_from())
         {
           this->_value.~_value_type_();  // NOLINT
         }
@@ -1522,7 +1599,7 @@ namespace detail
       }
       if(this->_status.have_error() && o._status.have_value())
       {
-        if(!trait::is_move_bitcopying<error_type>::value || this->_status.have_moved_from())
+        if(!trait::is_move_bitcopying<error_type>::value || !this->_status.have_moved_from())
         {
           this->_error.~_error_type_();  // NOLINT
         }
@@ -1534,6 +1611,286 @@ namespace detail
       make_ub(this->_value);
     }
   };
+
+  /* If one of T or E specialises `trait::niche` to name a bit pattern which a live
+  object of that type can never hold, and that bit pattern lies beyond the bytes
+  occupied by the other type, then we can infer which of value or error is present
+  by looking at the bit pattern, and the status_bitfield_type can be dropped. The
+  storage then becomes exactly as big as the larger of T and E.
+
+  Only value and error states are representable, so moved from, lost consistency,
+  error is errno and spare storage are not tracked.
+  */
+  template <class Owner, bool OwnerIsError> struct niche_status_type
+  {
+    using _niche = trait::niche<Owner>;
+    using _word_type = typename _niche::word_type;
+    static_assert(std::is_integral<_word_type>::value, "trait::niche<T>::word_type must be an integral type");
+
+    // This is an empty member of the storage's union, so it lives at the start of the storage
+    _word_type _word() const noexcept
+    {
+      _word_type ret;
+      std::memcpy(&ret, reinterpret_cast<const char *>(this) + _niche::offset, sizeof(ret));  // NOLINT
+      return ret;
+    }
+    void _set_niche() noexcept
+    {
+      const _word_type v = _niche::invalid;
+      std::memcpy(reinterpret_cast<char *>(this) + _niche::offset, &v, sizeof(v));  // NOLINT
+    }
+
+    bool have_value() const noexcept { return (_word() == _niche::invalid) == OwnerIsError; }
+    bool have_error() const noexcept { return (_word() == _niche::invalid) != OwnerIsError; }
+    constexpr bool have_exception() const noexcept { return false; }
+    constexpr bool have_lost_consistency() const noexcept { return false; }
+    constexpr bool have_error_is_errno() const noexcept { return false; }
+    constexpr bool have_moved_from() const noexcept { return false; }
+
+    constexpr niche_status_type &set_have_lost_consistency(bool /*unused*/) noexcept { return *this; }
+    constexpr niche_status_type &set_have_error_is_errno(bool /*unused*/) noexcept { return *this; }
+    constexpr niche_status_type &set_have_moved_from(bool /*unused*/) noexcept { return *this; }
+  };
+
+  // Used if the niche owner is trivial and so is the other type
+  template <class T, class E, bool NicheInError> struct value_storage_niche_trivial
+  {
+    using value_type = T;
+    using error_type = E;
+
+    using _value_type = value_type;
+    using _error_type = error_type;
+    using _value_type_ = devoid<value_type>;
+    using _error_type_ = devoid<error_type>;
+    using _status_type = niche_status_type<std::conditional_t<NicheInError, error_type, value_type>, NicheInError>;
+
+    union {
+      _value_type_ _value;
+      _error_type_ _error;
+      _status_type _status;
+    };
+    value_storage_niche_trivial(const value_storage_niche_trivial &) = default;             // NOLINT
+    value_storage_niche_trivial(value_storage_niche_trivial &&) = default;                  // NOLINT
+    value_storage_niche_trivial &operator=(const value_storage_niche_trivial &) = default;  // NOLINT
+    value_storage_niche_trivial &operator=(value_storage_niche_trivial &&) = default;       // NOLINT
+    ~value_storage_niche_trivial() = default;
+    template <class... Args>
+    constexpr explicit value_storage_niche_trivial(in_place_type_t<_value_type> /*unused*/,
+                                                   Args &&... args) noexcept(detail::is_nothrow_constructible<_value_type_, Args...>)
+        : _value(static_cast<Args &&>(args)...)
+    {
+      if(NicheInError)
+      {
+        _status._set_niche();
+      }
+    }
+    template <class U, class... Args>
+    constexpr value_storage_niche_trivial(in_place_type_t<_value_type> /*unused*/, std::initializer_list<U> il,
+                                          Args &&... args) noexcept(detail::is_nothrow_constructible<_value_type_, std::initializer_list<U>, Args...>)
+        : _value(il, static_cast<Args &&>(args)...)
+    {
+      if(NicheInError)
+      {
+        _status._set_niche();
+      }
+    }
+    template <class... Args>
+    constexpr explicit value_storage_niche_trivial(in_place_type_t<_error_type> /*unused*/,
+                                                   Args &&... args) noexcept(detail::is_nothrow_constructible<_error_type_, Args...>)
+        : _error(static_cast<Args &&>(args)...)
+    {
+      if(!NicheInError)
+      {
+        _status._set_niche();
+      }
+    }
+    template <class U, class... Args>
+    constexpr value_storage_niche_trivial(in_place_type_t<_error_type> /*unused*/, std::initializer_list<U> il,
+                                          Args &&... args) noexcept(detail::is_nothrow_constructible<_error_type_, std::initializer_list<U>, Args...>)
+        : _error(il, static_cast<Args &&>(args)...)
+    {
+      if(!NicheInError)
+      {
+        _status._set_niche();
+      }
+    }
+    constexpr void swap(value_storage_niche_trivial &o) noexcept
+    {
+      // storage is trivial, so just use assignment
+      auto temp = static_cast<value_storage_niche_trivial &&>(*this);
+      *this = static_cast<value_storage_niche_trivial &&>(o);
+      o = static_cast<value_storage_niche_trivial &&>(temp);
+    }
+  };
+
+  // Used if the niche owner is trivial, but the other type is not
+  template <class T, class E, bool NicheInError> struct value_storage_niche_nontrivial
+  {
+    using value_type = T;
+    using error_type = E;
+
+    using _value_type = value_type;
+    using _error_type = error_type;
+    using _value_type_ = devoid<value_type>;
+    using _error_type_ = devoid<error_type>;
+    using _status_type = niche_status_type<std::conditional_t<NicheInError, error_type, value_type>, NicheInError>;
+
+    union {
+      _value_type_ _value;
+      _error_type_ _error;
+      _status_type _status;
+    };
+    value_storage_niche_nontrivial(value_storage_niche_nontrivial &&o) noexcept  // NOLINT
+    {
+      if(o._status.have_value())
+      {
+        new(&_value) _value_type_(static_cast<_value_type_ &&>(o._value));  // NOLINT
+        _set_niche_after_value();
+      }
+      else
+      {
+        new(&_error) _error_type_(static_cast<_error_type_ &&>(o._error));  // NOLINT
+        _set_niche_after_error();
+      }
+    }
+    value_storage_niche_nontrivial(const value_storage_niche_nontrivial &o) noexcept(
+    std::is_nothrow_copy_constructible<_value_type_>::value &&std::is_nothrow_copy_constructible<_error_type_>::value)
+    {
+      if(o._status.have_value())
+      {
+        new(&_value) _value_type_(o._value);  // NOLINT
+        _set_niche_after_value();
+      }
+      else
+      {
+        new(&_error) _error_type_(o._error);  // NOLINT
+        _set_niche_after_error();
+      }
+    }
+    value_storage_niche_nontrivial &operator=(value_storage_niche_nontrivial &&o) noexcept(
+    std::is_nothrow_move_assignable<_value_type_>::value &&std::is_nothrow_move_assignable<_error_type_>::value)  // NOLINT
+    {
+      if(_status.have_value() && o._status.have_value())
+      {
+        _value = static_cast<_value_type_ &&>(o._value);  // NOLINT
+        return *this;
+      }
+      if(_status.have_error() && o._status.have_error())
+      {
+        _error = static_cast<_error_type_ &&>(o._error);  // NOLINT
+        return *this;
+      }
+      // Both types are nothrow move constructible, so this cannot fail
+      this->~value_storage_niche_nontrivial();
+      new(this) value_storage_niche_nontrivial(static_cast<value_storage_niche_nontrivial &&>(o));  // NOLINT
+      return *this;
+    }
+    value_storage_niche_nontrivial &operator=(const value_storage_niche_nontrivial &o) noexcept(
+    std::is_nothrow_copy_assignable<_value_type_>::value &&std::is_nothrow_copy_assignable<_error_type_>::value
+    &&std::is_nothrow_copy_constructible<_value_type_>::value &&std::is_nothrow_copy_constructible<_error_type_>::value)
+    {
+      if(_status.have_value() && o._status.have_value())
+      {
+        _value = o._value;  // NOLINT
+        return *this;
+      }
+      if(_status.have_error() && o._status.have_error())
+      {
+        _error = o._error;  // NOLINT
+        return *this;
+      }
+      // Copy first so a throwing copy leaves us untouched
+      value_storage_niche_nontrivial temp(o);
+      this->~value_storage_niche_nontrivial();
+      new(this) value_storage_niche_nontrivial(static_cast<value_storage_niche_nontrivial &&>(temp));  // NOLINT
+      return *this;
+    }
+    ~value_storage_niche_nontrivial() noexcept(std::is_nothrow_destructible<_value_type_>::value &&std::is_nothrow_destructible<_error_type_>::value)
+    {
+      if(_status.have_value())
+      {
+        this->_value.~_value_type_();  // NOLINT
+      }
+      else
+      {
+        this->_error.~_error_type_();  // NOLINT
+      }
+    }
+    template <class... Args>
+    explicit value_storage_niche_nontrivial(in_place_type_t<_value_type> /*unused*/,
+                                            Args &&... args) noexcept(detail::is_nothrow_constructible<_value_type_, Args...>)
+        : _value(static_cast<Args &&>(args)...)
+    {
+      _set_niche_after_value();
+    }
+    template <class U, class... Args>
+    value_storage_niche_nontrivial(in_place_type_t<_value_type> /*unused*/, std::initializer_list<U> il,
+                                   Args &&... args) noexcept(detail::is_nothrow_constructible<_value_type_, std::initializer_list<U>, Args...>)
+        : _value(il, static_cast<Args &&>(args)...)
+    {
+      _set_niche_after_value();
+    }
+    template <class... Args>
+    explicit value_storage_niche_nontrivial(in_place_type_t<_error_type> /*unused*/,
+                                            Args &&... args) noexcept(detail::is_nothrow_constructible<_error_type_, Args...>)
+        : _error(static_cast<Args &&>(args)...)
+    {
+      _set_niche_after_error();
+    }
+    template <class U, class... Args>
+    value_storage_niche_nontrivial(in_place_type_t<_error_type> /*unused*/, std::initializer_list<U> il,
+                                   Args &&... args) noexcept(detail::is_nothrow_constructible<_error_type_, std::initializer_list<U>, Args...>)
+        : _error(il, static_cast<Args &&>(args)...)
+    {
+      _set_niche_after_error();
+    }
+    void swap(value_storage_niche_nontrivial &o) noexcept(detail::is_nothrow_swappable<_value_type_>::value &&detail::is_nothrow_swappable<_error_type_>::value)
+    {
+      using std::swap;
+      if(_status.have_value() && o._status.have_value())
+      {
+        swap(_value, o._value);
+        return;
+      }
+      if(_status.have_error() && o._status.have_error())
+      {
+        swap(_error, o._error);
+        return;
+      }
+      // value/error or error/value, and both types are nothrow move constructible
+      value_storage_niche_nontrivial temp(static_cast<value_storage_niche_nontrivial &&>(o));
+      o.~value_storage_niche_nontrivial();
+      new(&o) value_storage_niche_nontrivial(static_cast<value_storage_niche_nontrivial &&>(*this));  // NOLINT
+      this->~value_storage_niche_nontrivial();
+      new(this) value_storage_niche_nontrivial(static_cast<value_storage_niche_nontrivial &&>(temp));  // NOLINT
+    }
+
+  private:
+    void _set_niche_after_value() noexcept
+    {
+      if(NicheInError)
+      {
+        _status._set_niche();
+      }
+    }
+    void _set_niche_after_error() noexcept
+    {
+      if(!NicheInError)
+      {
+        _status._set_niche();
+      }
+    }
+  };
+  template <class Base> struct value_storage_niche_delete_copy : Base  // NOLINT
+  {
+    using Base::Base;
+    using value_type = typename Base::value_type;
+    using error_type = typename Base::error_type;
+    value_storage_niche_delete_copy(const value_storage_niche_delete_copy &) = delete;
+    value_storage_niche_delete_copy(value_storage_niche_delete_copy &&) = default;  // NOLINT
+    value_storage_niche_delete_copy &operator=(const value_storage_niche_delete_copy &o) = delete;
+    value_storage_niche_delete_copy &operator=(value_storage_niche_delete_copy &&o) = default;  // NOLINT
+  };
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
@@ -1553,9 +1910,20 @@ namespace detail
     static constexpr bool value = true;
   };
 
+  template <class T, class E, bool = is_storage_trivial<T>::value &&is_storage_trivial<E>::value> struct is_storage_packable
+  {
+    static constexpr bool value = false;
+  };
+  template <class T, class E> struct is_storage_packable<T, E, true>
+  {
+    static constexpr size_t size = sizeof(value_storage_trivial<T, E>);
+    // Sizes of 1, 2 and 4 bytes are already a whole register
+    static constexpr bool value = OUTCOME_ENABLE_PACKED_STORAGE && size <= 16 && (size % 8) != 0 && size != 1 && size != 2 && size != 4;
+  };
   template <class T, class E>
   using value_storage_select_trivality =
-  std::conditional_t<is_storage_trivial<T>::value && is_storage_trivial<E>::value, value_storage_trivial<T, E>, value_storage_nontrivial<T, E>>;
+  std::conditional_t<is_storage_trivial<T>::value && is_storage_trivial<E>::value,
+                     std::conditional_t<is_storage_packable<T, E>::value, value_storage_packed<T, E>, value_storage_trivial<T, E>>, value_storage_nontrivial<T, E>>;
   template <class T, class E>
   using value_storage_select_move_constructor =
   std::conditional_t<std::is_move_constructible<devoid<T>>::value && std::is_move_constructible<devoid<E>>::value, value_storage_select_trivality<T, E>,
@@ -1578,7 +1946,53 @@ namespace detail
                      std::conditional_t<std::is_copy_assignable<devoid<T>>::value && std::is_copy_assignable<devoid<E>>::value,
                                         value_storage_nontrivial_copy_assignment<value_storage_select_move_assignment<T, E>>,
                                         value_storage_delete_copy_assignment<value_storage_select_move_assignment<T, E>>>>;
-  template <class T, class E> using value_storage_select_impl = value_storage_select_copy_assignment<T, E>;
+
+  // Owner's niche must be usable, and must not overlap the other type's bytes
+  template <class Owner, class Other, bool = trait::niche<Owner>::value> struct is_niche_usable
+  {
+    static constexpr bool value = false;
+  };
+  template <class Owner, class Other> struct is_niche_usable<Owner, Other, true>
+  {
+    using _niche = trait::niche<Owner>;
+    static constexpr bool value = !std::is_void<Owner>::value && !std::is_same<Owner, Other>::value && is_storage_trivial<Owner>::value  //
+                                  && _niche::offset + sizeof(typename _niche::word_type) <= sizeof(Owner)                               //
+                                  && _niche::offset >= (std::is_void<Other>::value ? 0 : sizeof(devoid<Other>))                         //
+                                  && std::is_nothrow_move_constructible<devoid<Other>>::value && std::is_move_assignable<devoid<Other>>::value;
+  };
+  template <class T, class E>
+  using value_storage_select_niche_trivality =
+  std::conditional_t<is_storage_trivial<T>::value && is_storage_trivial<E>::value, value_storage_niche_trivial<T, E, is_niche_usable<E, T>::value>,
+                     value_storage_niche_nontrivial<T, E, is_niche_usable<E, T>::value>>;
+  template <class T, class E>
+  using value_storage_select_niche_copy_assignment =
+  std::conditional_t<std::is_copy_assignable<devoid<T>>::value && std::is_copy_assignable<devoid<E>>::value, value_storage_select_niche_trivality<T, E>,
+                     value_storage_delete_copy_assignment<value_storage_select_niche_trivality<T, E>>>;
+  template <class T, class E>
+  using value_storage_select_niche_copy_constructor =
+  std::conditional_t<std::is_copy_constructible<devoid<T>>::value && std::is_copy_constructible<devoid<E>>::value,
+                     value_storage_select_niche_copy_assignment<T, E>, value_storage_niche_delete_copy<value_storage_select_niche_trivality<T, E>>>;
+
+  template <class T, class E>
+  using value_storage_select_impl = std::conditional_t<is_niche_usable<E, T>::value || is_niche_usable<T, E>::value,  //
+                                                       value_storage_select_niche_copy_constructor<T, E>, value_storage_select_copy_assignment<T, E>>;
+
+  // Spare storage is not available in every storage layout
+#if OUTCOME_ENABLE_COMPACT_STATUS
+  constexpr inline uint16_t _spare_storage_value(const status_bitfield_type & /*unused*/) noexcept { return 0; }
+  constexpr inline void _set_spare_storage_value(status_bitfield_type & /*unused*/, uint16_t /*unused*/) noexcept {}
+#else
+  constexpr inline uint16_t _spare_storage_value(const status_bitfield_type &s) noexcept { return s.spare_storage_value; }
+  constexpr inline void _set_spare_storage_value(status_bitfield_type &s, uint16_t v) noexcept { s.spare_storage_value = v; }
+#endif
+  template <class Owner, bool OwnerIsError> constexpr inline uint16_t _spare_storage_value(const niche_status_type<Owner, OwnerIsError> & /*unused*/) noexcept
+  {
+    return 0;
+  }
+  template <class Owner, bool OwnerIsError>
+  constexpr inline void _set_spare_storage_value(niche_status_type<Owner, OwnerIsError> & /*unused*/, uint16_t /*unused*/) noexcept
+  {
+  }
 #ifndef NDEBUG
   // Check is trivial in all ways except default constructibility
   // static_assert(std::is_trivial<value_storage_select_impl<int, long>>::value, "value_storage_select_impl<int, long> is not trivial!");
@@ -1599,6 +2013,12 @@ namespace detail
                 "value_storage_select_impl<int, long> is not trivially move assignable!");
   // Also check is standard layout
   static_assert(std::is_standard_layout<value_storage_select_impl<int, long>>::value, "value_storage_select_impl<int, long> is not a standard layout type!");
+#if OUTCOME_ENABLE_PACKED_STORAGE
+  static_assert(sizeof(value_storage_select_impl<short, char>) == (OUTCOME_ENABLE_COMPACT_STATUS ? 4 : 8),
+                "value_storage_select_impl<short, char> is not packed into a whole register!");
+  static_assert(std::is_trivially_copyable<value_storage_select_impl<short, char>>::value,
+                "value_storage_select_impl<short, char> is not trivially copyable!");
+#endif
 #endif
 }  // namespace detail
 
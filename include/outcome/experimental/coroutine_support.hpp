@@ -63,6 +63,29 @@ OUTCOME_V2_NAMESPACE_END
 
 #include "../detail/coroutine_support.ipp"
 
+#ifdef OUTCOME_FOUND_COROUTINE_HEADER
+#include "status-code/include/system_error2.hpp"
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace awaitables
+{
+  namespace detail
+  {
+    template <class E> struct cancelled_status_code
+    {
+      static constexpr bool value = true;
+      static E make() noexcept { return SYSTEM_ERROR2_NAMESPACE::generic_code(SYSTEM_ERROR2_NAMESPACE::errc::operation_canceled); }
+    };
+    template <> struct cancelled_error<SYSTEM_ERROR2_NAMESPACE::system_code> : cancelled_status_code<SYSTEM_ERROR2_NAMESPACE::system_code>
+    {
+    };
+    template <> struct cancelled_error<SYSTEM_ERROR2_NAMESPACE::error> : cancelled_status_code<SYSTEM_ERROR2_NAMESPACE::error>
+    {
+    };
+  }  // namespace detail
+}  // namespace awaitables
+OUTCOME_V2_NAMESPACE_END
+#endif
+
 #undef OUTCOME_COROUTINE_SUPPORT_NAMESPACE_BEGIN
 #undef OUTCOME_COROUTINE_SUPPORT_NAMESPACE_EXPORT_BEGIN
 #undef OUTCOME_COROUTINE_SUPPORT_NAMESPACE_END
@@ -32,21 +32,236 @@ Distributed under the Boost Software License, Version 1.0.
 
 // Boost.Outcome #include "boost/exception_ptr.hpp"
 
-SYSTEM_ERROR2_NAMESPACE_BEGIN
-template <class DomainType> inline std::exception_ptr basic_outcome_failure_exception_from_error(const status_code<DomainType> &sc)
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+namespace detail
 {
-  (void) sc;
-#ifdef __cpp_exceptions
-  try
+  using status_code_exception_factory = std::exception_ptr (*)(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &);
+
+  /* Domains whose `throw_exception()` throws something other than `status_error<DomainType>`
+  may provide `status_code_exception_from_error(const status_code<DomainType> &)` in the
+  namespace of their domain, returning the exception it would throw.
+  */
+  template <class T> void status_code_exception_from_error(const T &) = delete;
+  template <class DomainType, class = void> struct has_status_code_exception_hook : std::false_type
+  {
+  };
+  template <class DomainType>
+  struct has_status_code_exception_hook<DomainType, decltype((void) status_code_exception_from_error(std::declval<const SYSTEM_ERROR2_NAMESPACE::status_code<DomainType> &>()))>
+      : std::true_type
+  {
+  };
+  template <class DomainType> inline std::exception_ptr make_typed_status_code_exception_ptr(const SYSTEM_ERROR2_NAMESPACE::status_code<DomainType> &sc, std::true_type /*has hook*/)
+  {
+    // ADL discovered
+    return std::make_exception_ptr(status_code_exception_from_error(sc));
+  }
+  template <class DomainType> inline std::exception_ptr make_typed_status_code_exception_ptr(const SYSTEM_ERROR2_NAMESPACE::status_code<DomainType> &sc, std::false_type /*has hook*/)
   {
-    sc.throw_exception();
+    return std::make_exception_ptr(SYSTEM_ERROR2_NAMESPACE::status_error<DomainType>(sc));
   }
-  catch(...)
+
+  template <class DomainType> inline std::exception_ptr make_status_code_exception_ptr(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code)
   {
-    return std::current_exception();
+    // Same cast as the domain's own _do_throw_exception() performs on erased codes
+    return make_typed_status_code_exception_ptr(static_cast<const SYSTEM_ERROR2_NAMESPACE::status_code<DomainType> &>(code), has_status_code_exception_hook<DomainType>());
   }
+
+  template <class T> using status_code_value_is_cacheable = std::integral_constant<bool, std::is_integral<T>::value || std::is_enum<T>::value>;
+
+  /* Maps domain ids to factories constructing the exception for erased codes of that domain,
+  which is the domain's hook if it has one, else `status_error<DomainType>`, and whether the erased value of that domain identifies the code, rather than being say a
+  pointer to a heap allocated payload which could be reused by a different code later.
+  */
+  class status_code_exception_registry
+  {
+    static constexpr size_t _max_entries = 32;
+
+  public:
+    struct entry
+    {
+      SYSTEM_ERROR2_NAMESPACE::status_code_domain::unique_id_type id;
+      status_code_exception_factory factory;
+      bool cacheable;
+    };
+
+  private:
+    std::mutex _lock;
+    entry _entries[_max_entries]{};
+    std::atomic<size_t> _count{0};
+
+    status_code_exception_registry()
+    {
+      add<SYSTEM_ERROR2_NAMESPACE::_generic_code_domain>();
+#ifdef _WIN32
+      add<SYSTEM_ERROR2_NAMESPACE::_win32_code_domain>();
+      add<SYSTEM_ERROR2_NAMESPACE::_nt_code_domain>();
+#else
+      add<SYSTEM_ERROR2_NAMESPACE::_posix_code_domain>();
 #endif
-  return {};
+    }
+
+  public:
+    static status_code_exception_registry &get() noexcept
+    {
+      static status_code_exception_registry v;
+      return v;
+    }
+    template <class DomainType> bool add() noexcept
+    {
+      return add(DomainType::get().id(), &make_status_code_exception_ptr<DomainType>, status_code_value_is_cacheable<typename DomainType::value_type>::value);
+    }
+    bool add(SYSTEM_ERROR2_NAMESPACE::status_code_domain::unique_id_type id, status_code_exception_factory factory, bool cacheable) noexcept
+    {
+      std::lock_guard<std::mutex> g(_lock);
+      const size_t count = _count.load(std::memory_order_relaxed);
+      for(size_t n = 0; n < count; n++)
+      {
+        if(_entries[n].id == id)
+        {
+          return true;
+        }
+      }
+      if(count == _max_entries)
+      {
+        return false;
+      }
+      _entries[count] = {id, factory, cacheable};
+      _count.store(count + 1, std::memory_order_release);
+      return true;
+    }
+    const entry *find(SYSTEM_ERROR2_NAMESPACE::status_code_domain::unique_id_type id) const noexcept
+    {
+      const size_t count = _count.load(std::memory_order_acquire);
+      for(size_t n = 0; n < count; n++)
+      {
+        if(_entries[n].id == id)
+        {
+          return &_entries[n];
+        }
+      }
+      return nullptr;
+    }
+  };
+
+  /* Per-thread direct mapped cache of the exceptions for status codes whose value is an
+  integer, so the same code is converted into an exception only once per thread. The
+  exceptions are shared, so must be treated as immutable.
+  */
+  struct status_code_exception_cache
+  {
+    static constexpr size_t _entries = 16;
+    struct _entry
+    {
+      SYSTEM_ERROR2_NAMESPACE::status_code_domain::unique_id_type id{0};
+      uint64_t value{0};
+      std::exception_ptr ptr;
+    };
+    _entry entries[_entries];
+
+    static _entry &lookup(SYSTEM_ERROR2_NAMESPACE::status_code_domain::unique_id_type id, uint64_t value) noexcept
+    {
+      static thread_local status_code_exception_cache v;
+      return v.entries[((id ^ value) * 0x9E3779B97F4A7C15ULL) >> 60];
+    }
+  };
+
+  // Throws and catches, for domains neither registered nor with a hook
+  inline std::exception_ptr status_code_exception_by_throwing(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &sc)
+  {
+    (void) sc;
+#ifdef __cpp_exceptions
+    try
+    {
+      sc.throw_exception();
+    }
+    catch(...)
+    {
+      return std::current_exception();
+    }
+#endif
+    return {};
+  }
+
+  template <class Value, class F> inline std::exception_ptr status_code_exception_cached(SYSTEM_ERROR2_NAMESPACE::status_code_domain::unique_id_type id, const Value &v, F &&f, std::true_type /*cacheable*/)
+  {
+    auto &e = status_code_exception_cache::lookup(id, static_cast<uint64_t>(v));
+    if(e.ptr == nullptr || e.id != id || e.value != static_cast<uint64_t>(v))
+    {
+      e.ptr = f();
+      e.id = id;
+      e.value = static_cast<uint64_t>(v);
+    }
+    return e.ptr;
+  }
+  template <class Value, class F> inline std::exception_ptr status_code_exception_cached(SYSTEM_ERROR2_NAMESPACE::status_code_domain::unique_id_type /*unused*/, const Value & /*unused*/, F &&f, std::false_type /*cacheable*/)
+  {
+    return f();
+  }
+  /* Typed status codes construct their exception directly if their domain has a hook, or is
+  registered and so known to throw `status_error<DomainType>`. Otherwise the exception could
+  be of any type, so is thrown and caught.
+  */
+  template <class DomainType> inline std::exception_ptr status_code_exception_ptr(const SYSTEM_ERROR2_NAMESPACE::status_code<DomainType> &sc)
+  {
+    using value_type = typename DomainType::value_type;
+    using has_hook = has_status_code_exception_hook<DomainType>;
+    return status_code_exception_cached(
+    sc.domain().id(), sc.value(),
+    [&sc] {
+      if(has_hook::value || status_code_exception_registry::get().find(sc.domain().id()) != nullptr)
+      {
+        return make_typed_status_code_exception_ptr(sc, has_hook());
+      }
+      return status_code_exception_by_throwing(sc);
+    },
+    status_code_value_is_cacheable<value_type>());
+  }
+  /* Erased status codes construct their exception using the factory registered for their domain.
+  Only the erased values of registered domains with integral values are cached, as those of
+  indirecting or unknown domains may be addresses which get reused by unrelated codes.
+  */
+  template <class ErasedType> inline std::exception_ptr status_code_exception_ptr(const SYSTEM_ERROR2_NAMESPACE::status_code<SYSTEM_ERROR2_NAMESPACE::erased<ErasedType>> &sc)
+  {
+    if(sc.empty())
+    {
+      return {};
+    }
+    const auto *entry = status_code_exception_registry::get().find(sc.domain().id());
+    if(entry == nullptr)
+    {
+      return status_code_exception_by_throwing(sc);
+    }
+    if(!entry->cacheable)
+    {
+      return entry->factory(sc);
+    }
+    return status_code_exception_cached(
+    sc.domain().id(), sc.value(), [&] { return entry->factory(sc); }, status_code_value_is_cacheable<ErasedType>());
+  }
+}  // namespace detail
+
+namespace experimental
+{
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class DomainType> inline bool register_status_code_exception_domain() noexcept
+  {
+    return OUTCOME_V2_NAMESPACE::detail::status_code_exception_registry::get().template add<DomainType>();
+  }
+}  // namespace experimental
+
+OUTCOME_V2_NAMESPACE_END
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+template <class DomainType> inline std::exception_ptr basic_outcome_failure_exception_from_error(const status_code<DomainType> &sc)
+{
+  return OUTCOME_V2_NAMESPACE::detail::status_code_exception_ptr(sc);
 }
 SYSTEM_ERROR2_NAMESPACE_END
 
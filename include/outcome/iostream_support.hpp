@@ -38,7 +38,7 @@ namespace detail
 
   template <template <class, class> class ValueStorage, class T, class E> inline std::ostream &value_storage_out(std::ostream &s, const ValueStorage<T, E> &v)
   {
-    s << static_cast<uint16_t>(v._status.status_value) << " " << v._status.spare_storage_value << " ";
+    s << static_cast<uint16_t>(v._status.status_value) << " " << _spare_storage_value(v._status) << " ";
     if(v._status.have_value())
     {
       s << v._value;  // NOLINT
@@ -51,7 +51,7 @@ namespace detail
   }
   template <template <class, class> class ValueStorage, class E> inline std::ostream &value_storage_out(std::ostream &s, const ValueStorage<void, E> &v)
   {
-    s << static_cast<uint16_t>(v._status.status_value) << " " << v._status.spare_storage_value << " ";
+    s << static_cast<uint16_t>(v._status.status_value) << " " << _spare_storage_value(v._status) << " ";
     if(v._status.have_error())
     {
       s << v._error;  // NOLINT
@@ -60,7 +60,7 @@ namespace detail
   }
   template <template <class, class> class ValueStorage, class T> inline std::ostream &value_storage_out(std::ostream &s, const ValueStorage<T, void> &v)
   {
-    s << static_cast<uint16_t>(v._status.status_value) << " " << v._status.spare_storage_value << " ";
+    s << static_cast<uint16_t>(v._status.status_value) << " " << _spare_storage_value(v._status) << " ";
     if(v._status.have_value())
     {
       s << v._value;  // NOLINT
@@ -79,7 +79,7 @@ namespace detail
     uint16_t x, y;
     s >> x >> y;
     v._status.status_value = static_cast<detail::status>(x);
-    v._status.spare_storage_value = y;
+    _set_spare_storage_value(v._status, y);
     if(v._status.have_value())
     {
       new(&v._value) decltype(v._value)();  // NOLINT
@@ -100,7 +100,7 @@ namespace detail
     uint16_t x, y;
     s >> x >> y;
     v._status.status_value = static_cast<detail::status>(x);
-    v._status.spare_storage_value = y;
+    _set_spare_storage_value(v._status, y);
     if(v._status.have_error())
     {
       new(&v._error) decltype(v._error)();  // NOLINT
@@ -116,7 +116,7 @@ namespace detail
     uint16_t x, y;
     s >> x >> y;
     v._status.status_value = static_cast<detail::status>(x);
-    v._status.spare_storage_value = y;
+    _set_spare_storage_value(v._status, y);
     if(v._status.have_value())
     {
       new(&v._value) decltype(v._value)();  // NOLINT
@@ -126,6 +126,118 @@ namespace detail
   }
   template <class T, class E> inline std::istream &operator>>(std::istream &s, value_storage_trivial<T, E> &v) { return value_storage_in(s, v); }
   template <class T, class E> inline std::istream &operator>>(std::istream &s, value_storage_nontrivial<T, E> &v) { return value_storage_in(s, v); }
+
+  // Niche storage has no status bitfield, so synthesise one
+  template <class ValueStorage> inline uint16_t niche_status_out(const ValueStorage &v)
+  {
+    return static_cast<uint16_t>(v._status.have_value() ? status::have_value : status::have_error);
+  }
+  template <template <class, class, bool> class ValueStorage, class T, class E, bool N>
+  inline std::ostream &value_storage_out(std::ostream &s, const ValueStorage<T, E, N> &v)
+  {
+    s << niche_status_out(v) << " " << 0 << " ";
+    if(v._status.have_value())
+    {
+      s << v._value;  // NOLINT
+    }
+    else
+    {
+      s << v._error;  // NOLINT
+    }
+    return s;
+  }
+  template <template <class, class, bool> class ValueStorage, class E, bool N>
+  inline std::ostream &value_storage_out(std::ostream &s, const ValueStorage<void, E, N> &v)
+  {
+    s << niche_status_out(v) << " " << 0 << " ";
+    if(v._status.have_error())
+    {
+      s << v._error;  // NOLINT
+    }
+    return s;
+  }
+  template <template <class, class, bool> class ValueStorage, class T, bool N>
+  inline std::ostream &value_storage_out(std::ostream &s, const ValueStorage<T, void, N> &v)
+  {
+    s << niche_status_out(v) << " " << 0 << " ";
+    if(v._status.have_value())
+    {
+      s << v._value;  // NOLINT
+    }
+    return s;
+  }
+  template <class T, class E, bool N> inline std::ostream &operator<<(std::ostream &s, const value_storage_niche_trivial<T, E, N> &v)
+  {
+    return value_storage_out(s, v);
+  }
+  template <class T, class E, bool N> inline std::ostream &operator<<(std::ostream &s, const value_storage_niche_nontrivial<T, E, N> &v)
+  {
+    return value_storage_out(s, v);
+  }
+
+  template <template <class, class, bool> class ValueStorage, class T, class E, bool N>
+  inline std::istream &value_storage_in(std::istream &s, ValueStorage<T, E, N> &v)
+  {
+    using type = ValueStorage<T, E, N>;
+    uint16_t x, y;
+    s >> x >> y;
+    v.~type();
+    if((x & static_cast<uint16_t>(status::have_value)) != 0)
+    {
+      new(&v) type(in_place_type<typename type::_value_type>);
+      s >> v._value;  // NOLINT
+    }
+    else
+    {
+      new(&v) type(in_place_type<typename type::_error_type>);
+      s >> v._error;  // NOLINT
+    }
+    return s;
+  }
+  template <template <class, class, bool> class ValueStorage, class E, bool N>
+  inline std::istream &value_storage_in(std::istream &s, ValueStorage<void, E, N> &v)
+  {
+    using type = ValueStorage<void, E, N>;
+    uint16_t x, y;
+    s >> x >> y;
+    v.~type();
+    if((x & static_cast<uint16_t>(status::have_value)) != 0)
+    {
+      new(&v) type(in_place_type<typename type::_value_type>);
+    }
+    else
+    {
+      new(&v) type(in_place_type<typename type::_error_type>);
+      s >> v._error;  // NOLINT
+    }
+    return s;
+  }
+  template <template <class, class, bool> class ValueStorage, class T, bool N>
+  inline std::istream &value_storage_in(std::istream &s, ValueStorage<T, void, N> &v)
+  {
+    using type = ValueStorage<T, void, N>;
+    uint16_t x, y;
+    s >> x >> y;
+    v.~type();
+    if((x & static_cast<uint16_t>(status::have_value)) != 0)
+    {
+      new(&v) type(in_place_type<typename type::_value_type>);
+      s >> v._value;  // NOLINT
+    }
+    else
+    {
+      new(&v) type(in_place_type<typename type::_error_type>);
+    }
+    return s;
+  }
+  template <class T, class E, bool N> inline std::istream &operator>>(std::istream &s, value_storage_niche_trivial<T, E, N> &v)
+  {
+    return value_storage_in(s, v);
+  }
+  template <class T, class E, bool N> inline std::istream &operator>>(std::istream &s, value_storage_niche_nontrivial<T, E, N> &v)
+  {
+    return value_storage_in(s, v);
+  }
   OUTCOME_TEMPLATE(class T)
   OUTCOME_TREQUIRES(OUTCOME_TPRED(!std::is_constructible<std::error_code, T>::value))
   inline std::string safe_message(T && /*unused*/) { return {}; }
@@ -0,0 +1,1034 @@
+/* An epoll reactor for Outcome's awaitables
+(C) 2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2020
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_REACTOR_HPP
+#define OUTCOME_REACTOR_HPP
+
+#include "detail/coroutine_awaitables.hpp"
+
+#if defined(OUTCOME_FOUND_COROUTINE_HEADER) && defined(__linux__)
+
+#include "result.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+namespace awaitables
+{
+  class reactor;
+  class io_handle;
+
+  namespace detail
+  {
+    /* A suspended I/O operation. attempt() performs the operation, returning false if it would
+    block. abandon() unparks it, so it completes with ECANCELED when resumed.
+    */
+    struct io_waiter
+    {
+      bool (*attempt)(io_waiter *) noexcept;
+      void (*abandon)(io_waiter *) noexcept;
+      coroutine_handle<> handle;
+      io_waiter *next_abandoned{nullptr};
+    };
+
+    /* Operations whose cancellation was requested from outside the reactor's run_once(),
+    possibly on another thread, queued for the reactor to abandon in its next run_once(), as
+    only the thread running the reactor may touch its state. Posting signals an eventfd
+    registered with the reactor's epoll, so run_once() is woken to do so.
+    */
+    struct io_cancellations
+    {
+      int fd;  // an eventfd
+      std::mutex lock;
+      io_waiter *abandoned{nullptr};
+
+      explicit io_cancellations(int efd) noexcept
+          : fd(efd)
+      {
+      }
+      io_cancellations(const io_cancellations &) = delete;
+      io_cancellations &operator=(const io_cancellations &) = delete;
+      ~io_cancellations() { ::close(fd); }
+
+      // The cancellations of the reactor whose run_once() is running on this thread, if any
+      static io_cancellations *&running() noexcept
+      {
+        static thread_local io_cancellations *v;
+        return v;
+      }
+
+      void post(io_waiter *w) noexcept
+      {
+        {
+          std::lock_guard<std::mutex> g(lock);
+          w->next_abandoned = abandoned;
+          abandoned = w;
+        }
+        const uint64_t one = 1;
+        (void) ::write(fd, &one, sizeof(one));
+      }
+      // Called when the eventfd becomes readable
+      io_waiter *take() noexcept
+      {
+        uint64_t count;
+        (void) ::read(fd, &count, sizeof(count));
+        std::lock_guard<std::mutex> g(lock);
+        io_waiter *ret = abandoned;
+        abandoned = nullptr;
+        return ret;
+      }
+    };
+
+    // Registered with epoll once per file descriptor, edge triggered for both directions
+    struct io_state
+    {
+      int fd;
+      int epfd;
+      bool is_socket;
+      io_cancellations *cancellations;
+      io_waiter *reader{nullptr};
+      io_waiter *writer{nullptr};
+    };
+
+    class sleep_awaitable;
+    template <class Awaitable> class deadline_awaitable;
+
+    inline std::error_code last_error() noexcept { return {errno, std::system_category()}; }
+
+    struct read_op
+    {
+      using value_type = size_t;
+      static constexpr bool is_write = false;
+      void *buffer;
+      size_t bytes;
+      ssize_t operator()(io_state *s) const noexcept { return ::read(s->fd, buffer, bytes); }
+    };
+    struct write_op
+    {
+      using value_type = size_t;
+      static constexpr bool is_write = true;
+      const void *buffer;
+      size_t bytes;
+      // Writing to a socket whose peer has gone must fail with EPIPE, not raise SIGPIPE
+      ssize_t operator()(io_state *s) const noexcept { return s->is_socket ? ::send(s->fd, buffer, bytes, MSG_NOSIGNAL) : ::write(s->fd, buffer, bytes); }
+    };
+    struct accept_op
+    {
+      using value_type = int;
+      static constexpr bool is_write = false;
+      ssize_t operator()(io_state *s) const noexcept { return ::accept4(s->fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC); }
+    };
+
+    /* The awaitable returned by the I/O functions. The operation is attempted immediately,
+    and only if it would block does the awaiting coroutine suspend until the reactor sees
+    the file descriptor become ready, and completes the operation on its behalf. If the
+    awaiting coroutine has a cancellation token, requesting cancellation abandons the
+    operation, resuming the coroutine with `errc::operation_canceled`. That happens there
+    and then if requested from within the reactor's run_once(), otherwise the operation is
+    handed to the reactor to abandon in its next run_once(). While the operation is
+    suspended, the reactor deregisters the callback before each attempt, so an operation
+    can never be both completed and abandoned.
+    */
+    template <class Op> class OUTCOME_NODISCARD io_awaitable : io_waiter, cancellation_callback
+    {
+      using value_type = typename Op::value_type;
+
+      io_state *_state;
+      Op _op;
+      value_type _value{};
+      int _errcode{0};
+      cancellation_token _token;
+      bool _registered{false};  // with _token, while suspended
+
+      io_waiter *&_parked() noexcept { return Op::is_write ? _state->writer : _state->reader; }
+      static bool _attempt(io_waiter *w) noexcept
+      {
+        auto *self = static_cast<io_awaitable *>(w);
+        const bool registered = self->_registered;  // only ever while attempted by the reactor
+        if(registered)
+        {
+          self->_registered = false;
+          if(!self->_token._remove_callback(self))
+          {
+            return false;  // abandoned, or handed to the reactor to abandon
+          }
+        }
+        for(;;)
+        {
+          const ssize_t n = self->_op(self->_state);
+          if(n >= 0)
+          {
+            self->_value = static_cast<value_type>(n);
+            break;
+          }
+          if(errno == EINTR)
+          {
+            continue;
+          }
+          if(errno == EAGAIN || errno == EWOULDBLOCK)
+          {
+            // Still suspended, unless cancellation was requested while the callback was deregistered
+            return registered && !self->_register();
+          }
+          self->_errcode = errno;
+          break;
+        }
+        return true;
+      }
+      // Returns false, setting ECANCELED, if cancellation has already been requested
+      bool _register() noexcept
+      {
+        if(_token.can_be_cancelled())
+        {
+          if(!_token._add_callback(this))
+          {
+            _errcode = ECANCELED;
+            return false;
+          }
+          _registered = true;
+        }
+        return true;
+      }
+      static void _abandon(io_waiter *w) noexcept
+      {
+        auto *self = static_cast<io_awaitable *>(w);
+        self->_parked() = nullptr;
+        self->_errcode = ECANCELED;
+      }
+      static void _cancel(cancellation_callback *cb) noexcept
+      {
+        auto *self = static_cast<io_awaitable *>(cb);
+        io_cancellations *c = self->_state->cancellations;
+        if(io_cancellations::running() != c)
+        {
+          c->post(self);
+          return;
+        }
+        _abandon(self);
+        self->handle.resume();
+      }
+
+      friend inline void inherit_cancellation_token(io_awaitable &a, const cancellation_token &t) noexcept { a._token = t; }
+
+    public:
+      io_awaitable(io_state *state, Op op) noexcept
+          : io_waiter{&_attempt, &_abandon, {}}
+          , cancellation_callback{&_cancel}
+          , _state(state)
+          , _op(op)
+      {
+      }
+
+      bool await_ready() noexcept { return _attempt(this); }
+      bool await_suspend(coroutine_handle<> h) noexcept
+      {
+        handle = h;
+        _parked() = this;
+        if(!_register())
+        {
+          _parked() = nullptr;
+          return false;
+        }
+        return true;
+      }
+      result<value_type, std::error_code> await_resume() noexcept
+      {
+        if(_errcode != 0)
+        {
+          return std::error_code(_errcode, std::system_category());
+        }
+        return _value;
+      }
+    };
+
+    // A pending timer, linked into a slot of the timer wheel
+    struct timer_entry
+    {
+      timer_entry *prev{nullptr}, *next{nullptr};
+      uint64_t expiry{0};  // in ticks of the wheel
+      unsigned where{0};   // level * slots + slot, or expired_slot
+      void (*fire)(timer_entry *) noexcept{nullptr};
+    };
+
+    /* A hierarchical timer wheel of four levels of 64 slots, with a tick of a millisecond,
+    driving a single timerfd. Level 0 holds timers due within 64 ticks in the slot of their
+    expiry, level 1 those due within 64^2 ticks in the slot of their expiry divided by 64,
+    and so on. When the current tick reaches a multiple of 64^n, the due slot of level n is
+    cascaded down into the lower levels. Timers further out than the wheel spans wait in its
+    last slot and are cascaded again until they come within range. Adding and removing are
+    O(1), and each timer is cascaded at most three times. A bitmap of occupied slots per
+    level lets the wheel jump straight to the next tick at which anything happens, which is
+    also when the timerfd is next armed for.
+    */
+    class timer_wheel
+    {
+    public:
+      static constexpr unsigned bits = 6, slots = 1U << bits, levels = 4;
+      static constexpr unsigned expired_slot = levels * slots;
+      static constexpr uint64_t none = UINT64_MAX;
+
+    private:
+      int _timerfd;
+      uint64_t _start_ns;
+      uint64_t _now{0};            // the last tick processed
+      uint64_t _armed{none};       // the tick the timerfd is armed for
+      uint64_t _occupied[levels]{};
+      size_t _count{0};            // timers in the wheel, not counting those expired
+      timer_entry _slots[levels][slots];
+      timer_entry _expired;        // timers due, yet to be fired
+
+      static uint64_t _clock_ns() noexcept
+      {
+        struct timespec ts;
+        ::clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+      }
+      static void _init(timer_entry &head) noexcept { head.prev = head.next = &head; }
+      static void _link(timer_entry &head, timer_entry *e) noexcept
+      {
+        e->next = &head;
+        e->prev = head.prev;
+        head.prev->next = e;
+        head.prev = e;
+      }
+      void _place(timer_entry *e) noexcept
+      {
+        const uint64_t delta = (e->expiry > _now) ? e->expiry - _now : 0;
+        uint64_t at = e->expiry;
+        unsigned level = 0;
+        while(level < levels - 1 && delta >= (uint64_t(1) << (bits * (level + 1))))
+        {
+          ++level;
+        }
+        if(delta >= (uint64_t(1) << (bits * levels)))
+        {
+          at = _now + (uint64_t(1) << (bits * levels)) - 1;
+        }
+        const auto slot = static_cast<unsigned>((at >> (bits * level)) & (slots - 1));
+        e->where = level * slots + slot;
+        _link(_slots[level][slot], e);
+        _occupied[level] |= uint64_t(1) << slot;
+      }
+      // Removes every timer from a slot, returning them as a list terminated by the slot's head
+      timer_entry *_take(unsigned level, unsigned slot, timer_entry *&end) noexcept
+      {
+        timer_entry &head = _slots[level][slot];
+        timer_entry *first = head.next;
+        end = &head;
+        _init(head);
+        _occupied[level] &= ~(uint64_t(1) << slot);
+        return first;
+      }
+
+    public:
+      explicit timer_wheel(int timerfd) noexcept
+          : _timerfd(timerfd)
+          , _start_ns(_clock_ns())
+      {
+        for(auto &level : _slots)
+        {
+          for(auto &head : level)
+          {
+            _init(head);
+          }
+        }
+        _init(_expired);
+      }
+      timer_wheel(const timer_wheel &) = delete;
+      timer_wheel &operator=(const timer_wheel &) = delete;
+      ~timer_wheel() { ::close(_timerfd); }
+
+      int native_handle() const noexcept { return _timerfd; }
+
+      // The tick at or after which a timer lasting `ns` from now may fire
+      uint64_t expiry_after(uint64_t ns) const noexcept { return (_clock_ns() - _start_ns + ns + 999999) / 1000000; }
+      uint64_t current_tick() const noexcept { return (_clock_ns() - _start_ns) / 1000000; }
+
+      void add(timer_entry *e) noexcept
+      {
+        if(e->expiry <= _now)
+        {
+          e->expiry = _now + 1;  // the current tick has already been processed
+        }
+        _place(e);
+        ++_count;
+        rearm();
+      }
+      void remove(timer_entry *e) noexcept
+      {
+        e->prev->next = e->next;
+        e->next->prev = e->prev;
+        if(e->where != expired_slot)
+        {
+          const unsigned level = e->where / slots, slot = e->where % slots;
+          if(_slots[level][slot].next == &_slots[level][slot])
+          {
+            _occupied[level] &= ~(uint64_t(1) << slot);
+          }
+          --_count;
+        }
+        e->prev = e->next = nullptr;
+      }
+
+      // The next tick at which a timer expires or a slot must be cascaded
+      uint64_t next_tick() const noexcept
+      {
+        uint64_t ret = none;
+        for(unsigned level = 0; level < levels; level++)
+        {
+          if(_occupied[level] != 0)
+          {
+            const uint64_t index = _now >> (bits * level);
+            const auto from = static_cast<unsigned>((index + 1) & (slots - 1));
+            const uint64_t rotated = (_occupied[level] >> from) | ((from != 0) ? (_occupied[level] << (slots - from)) : 0);
+            const uint64_t tick = (index + 1 + static_cast<unsigned>(__builtin_ctzll(rotated))) << (bits * level);
+            if(tick < ret)
+            {
+              ret = tick;
+            }
+          }
+        }
+        return ret;
+      }
+
+      // Processes every tick up to `to`, moving the timers due onto the expired list
+      void advance(uint64_t to) noexcept
+      {
+        while(_count > 0)
+        {
+          const uint64_t tick = next_tick();
+          if(tick > to)
+          {
+            break;
+          }
+          _now = tick;
+          for(unsigned level = levels - 1; level > 0; level--)
+          {
+            if((_now & ((uint64_t(1) << (bits * level)) - 1)) == 0)
+            {
+              timer_entry *end, *e = _take(level, static_cast<unsigned>((_now >> (bits * level)) & (slots - 1)), end);
+              while(e != end)
+              {
+                timer_entry *next = e->next;
+                _place(e);
+                e = next;
+              }
+            }
+          }
+          timer_entry *end, *e = _take(0, static_cast<unsigned>(_now & (slots - 1)), end);
+          while(e != end)
+          {
+            timer_entry *next = e->next;
+            e->where = expired_slot;
+            _link(_expired, e);
+            --_count;
+            e = next;
+          }
+        }
+        if(to > _now)
+        {
+          _now = to;
+        }
+      }
+      // Removes the next expired timer, if any
+      timer_entry *pop_expired() noexcept
+      {
+        if(_expired.next == &_expired)
+        {
+          return nullptr;
+        }
+        timer_entry *e = _expired.next;
+        remove(e);
+        return e;
+      }
+
+      // Arms the timerfd for the next tick at which anything happens, if that changed
+      void rearm() noexcept
+      {
+        const uint64_t tick = next_tick();
+        if(tick == _armed)
+        {
+          return;
+        }
+        _armed = tick;
+        struct itimerspec its
+        {
+        };
+        if(tick != none)
+        {
+          const uint64_t ns = _start_ns + tick * 1000000;
+          its.it_value.tv_sec = static_cast<time_t>(ns / 1000000000);
+          its.it_value.tv_nsec = static_cast<long>(ns % 1000000000);
+        }
+        ::timerfd_settime(_timerfd, TFD_TIMER_ABSTIME, &its, nullptr);
+      }
+      // Called when the timerfd becomes readable
+      void expire() noexcept
+      {
+        uint64_t count;
+        (void) ::read(_timerfd, &count, sizeof(count));
+        _armed = none;
+        advance(current_tick());
+      }
+    };
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  io_handle. Potential doc page: `io_handle`
+*/
+  class io_handle
+  {
+    friend class reactor;
+    friend inline detail::io_awaitable<detail::read_op> async_read(io_handle &h, void *buffer, size_t bytes) noexcept;
+    friend inline detail::io_awaitable<detail::write_op> async_write(io_handle &h, const void *buffer, size_t bytes) noexcept;
+    friend inline detail::io_awaitable<detail::accept_op> async_accept(io_handle &h) noexcept;
+
+    detail::io_state *_state{nullptr};
+
+    explicit io_handle(detail::io_state *state) noexcept
+        : _state(state)
+    {
+    }
+
+  public:
+    //! Default constructor, refers to no file descriptor.
+    io_handle() = default;
+    io_handle(const io_handle &) = delete;
+    io_handle(io_handle &&o) noexcept
+        : _state(o._state)
+    {
+      o._state = nullptr;
+    }
+    io_handle &operator=(const io_handle &) = delete;
+    io_handle &operator=(io_handle &&o) noexcept
+    {
+      if(this != &o)
+      {
+        this->~io_handle();
+        new(this) io_handle(static_cast<io_handle &&>(o));
+      }
+      return *this;
+    }
+    //! Deregisters and closes the file descriptor. No operation may be pending on it.
+    ~io_handle()
+    {
+      if(_state != nullptr)
+      {
+        ::epoll_ctl(_state->epfd, EPOLL_CTL_DEL, _state->fd, nullptr);
+        ::close(_state->fd);
+        delete _state;
+        _state = nullptr;
+      }
+    }
+
+    //! True if this refers to a file descriptor.
+    explicit operator bool() const noexcept { return _state != nullptr; }
+    //! The file descriptor, or -1.
+    int native_handle() const noexcept { return (_state != nullptr) ? _state->fd : -1; }
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  reactor. Potential doc page: `reactor`
+*/
+  class reactor
+  {
+    friend class detail::sleep_awaitable;
+    template <class Awaitable> friend class detail::deadline_awaitable;
+
+    int _epfd{-1};
+    std::unique_ptr<detail::timer_wheel> _timers;
+    std::unique_ptr<detail::io_cancellations> _cancellations;
+
+    reactor(int epfd, detail::timer_wheel *timers, detail::io_cancellations *cancellations) noexcept
+        : _epfd(epfd)
+        , _timers(timers)
+        , _cancellations(cancellations)
+    {
+    }
+
+  public:
+    //! Creates a reactor, or returns why it could not be created.
+    static result<reactor, std::error_code> make() noexcept
+    {
+      const int epfd = ::epoll_create1(EPOLL_CLOEXEC);
+      if(epfd == -1)
+      {
+        return detail::last_error();
+      }
+      // Every timer is driven by one timerfd, registered with a null pointer to tell it from the io_handles
+      const int timerfd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+      if(timerfd == -1)
+      {
+        auto ret = detail::last_error();
+        ::close(epfd);
+        return ret;
+      }
+      auto *timers = new(std::nothrow) detail::timer_wheel(timerfd);
+      if(timers == nullptr)
+      {
+        ::close(timerfd);
+        ::close(epfd);
+        return std::make_error_code(std::errc::not_enough_memory);
+      }
+      epoll_event ev{};
+      ev.events = EPOLLIN;
+      ev.data.ptr = nullptr;
+      if(::epoll_ctl(epfd, EPOLL_CTL_ADD, timerfd, &ev) == -1)
+      {
+        auto ret = detail::last_error();
+        delete timers;
+        ::close(epfd);
+        return ret;
+      }
+      // Cancellations from outside run_once() are signalled by an eventfd, registered with a pointer to their queue
+      const int efd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+      if(efd == -1)
+      {
+        auto ret = detail::last_error();
+        delete timers;
+        ::close(epfd);
+        return ret;
+      }
+      auto *cancellations = new(std::nothrow) detail::io_cancellations(efd);
+      if(cancellations == nullptr)
+      {
+        ::close(efd);
+        delete timers;
+        ::close(epfd);
+        return std::make_error_code(std::errc::not_enough_memory);
+      }
+      ev.data.ptr = cancellations;
+      if(::epoll_ctl(epfd, EPOLL_CTL_ADD, efd, &ev) == -1)
+      {
+        auto ret = detail::last_error();
+        delete cancellations;
+        delete timers;
+        ::close(epfd);
+        return ret;
+      }
+      return reactor(epfd, timers, cancellations);
+    }
+    reactor(const reactor &) = delete;
+    reactor(reactor &&o) noexcept
+        : _epfd(o._epfd)
+        , _timers(static_cast<std::unique_ptr<detail::timer_wheel> &&>(o._timers))
+        , _cancellations(static_cast<std::unique_ptr<detail::io_cancellations> &&>(o._cancellations))
+    {
+      o._epfd = -1;
+    }
+    reactor &operator=(const reactor &) = delete;
+    reactor &operator=(reactor &&o) noexcept
+    {
+      if(this != &o)
+      {
+        this->~reactor();
+        new(this) reactor(static_cast<reactor &&>(o));
+      }
+      return *this;
+    }
+    //! Closes the reactor. Every `io_handle` attached to it must be destroyed first, and no timer may be pending.
+    ~reactor()
+    {
+      if(_epfd != -1)
+      {
+        ::close(_epfd);
+        _epfd = -1;
+      }
+    }
+
+    /*! Takes ownership of the file descriptor `fd`, making it non-blocking and registering
+    it with the reactor. On failure, ownership of `fd` stays with the caller.
+    */
+    result<io_handle, std::error_code> attach(int fd) noexcept
+    {
+      const int flags = ::fcntl(fd, F_GETFL);
+      if(flags == -1 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1)
+      {
+        return detail::last_error();
+      }
+      struct stat st;
+      if(::fstat(fd, &st) == -1)
+      {
+        return detail::last_error();
+      }
+      auto *state = new(std::nothrow) detail::io_state{fd, _epfd, S_ISSOCK(st.st_mode), _cancellations.get()};
+      if(state == nullptr)
+      {
+        return std::make_error_code(std::errc::not_enough_memory);
+      }
+      epoll_event ev{};
+      ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+      ev.data.ptr = state;
+      if(::epoll_ctl(_epfd, EPOLL_CTL_ADD, fd, &ev) == -1)
+      {
+        auto ret = detail::last_error();
+        delete state;
+        return ret;
+      }
+      return io_handle(state);
+    }
+
+    /*! Waits up to `timeout_ms` milliseconds, or forever if negative, for attached file
+    descriptors to become ready, timers to expire, or cancellation to be requested from
+    outside `run_once()`. Completes the operations pending on the ready file descriptors,
+    then resumes the coroutines which awaited those operations, then those whose operations
+    were abandoned, then those whose timers expired. Returns the number of coroutines resumed.
+    */
+    result<size_t, std::error_code> run_once(int timeout_ms = -1) noexcept
+    {
+      static constexpr int max_events = 64;
+      epoll_event events[max_events];
+      const int count = ::epoll_wait(_epfd, events, max_events, timeout_ms);
+      if(count == -1)
+      {
+        if(errno == EINTR)
+        {
+          return 0;
+        }
+        return detail::last_error();
+      }
+      // Cancellation requested by the coroutines resumed below abandons their operations there and then
+      struct running_scope
+      {
+        detail::io_cancellations *prev;
+        explicit running_scope(detail::io_cancellations *c) noexcept
+            : prev(detail::io_cancellations::running())
+        {
+          detail::io_cancellations::running() = c;
+        }
+        running_scope(const running_scope &) = delete;
+        running_scope &operator=(const running_scope &) = delete;
+        ~running_scope() { detail::io_cancellations::running() = prev; }
+      } running(_cancellations.get());
+      // Complete every operation before resuming any coroutine, as a resumed coroutine may destroy io_handles
+      detail::io_waiter *ready[max_events * 2];
+      size_t readies = 0;
+      detail::io_waiter *abandoned = nullptr;
+      bool timers_due = false;
+      for(int n = 0; n < count; n++)
+      {
+        if(events[n].data.ptr == _cancellations.get())
+        {
+          abandoned = _cancellations->take();
+          for(detail::io_waiter *w = abandoned; w != nullptr; w = w->next_abandoned)
+          {
+            w->abandon(w);
+          }
+          continue;
+        }
+        auto *state = static_cast<detail::io_state *>(events[n].data.ptr);
+        if(state == nullptr)
+        {
+          timers_due = true;
+          continue;
+        }
+        const uint32_t e = events[n].events;
+        if((e & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0 && state->reader != nullptr && state->reader->attempt(state->reader))
+        {
+          ready[readies++] = state->reader;
+          state->reader = nullptr;
+        }
+        if((e & (EPOLLOUT | EPOLLHUP | EPOLLERR)) != 0 && state->writer != nullptr && state->writer->attempt(state->writer))
+        {
+          ready[readies++] = state->writer;
+          state->writer = nullptr;
+        }
+      }
+      for(size_t n = 0; n < readies; n++)
+      {
+        ready[n]->handle.resume();
+      }
+      while(abandoned != nullptr)
+      {
+        detail::io_waiter *w = abandoned;
+        abandoned = w->next_abandoned;
+        w->handle.resume();
+        ++readies;
+      }
+      // Timers are fired after I/O, so an operation completing in time cancels its deadline
+      if(timers_due)
+      {
+        _timers->expire();
+        while(detail::timer_entry *e = _timers->pop_expired())
+        {
+          e->fire(e);
+          ++readies;
+        }
+        _timers->rearm();
+      }
+      return readies;
+    }
+  };
+
+  namespace detail
+  {
+    inline uint64_t timeout_ns(std::chrono::nanoseconds d) noexcept { return (d.count() > 0) ? static_cast<uint64_t>(d.count()) : 0; }
+
+    // The awaitable returned by sleep_for()
+    class OUTCOME_NODISCARD sleep_awaitable : timer_entry
+    {
+      timer_wheel *_wheel;
+      uint64_t _ns;
+      coroutine_handle<> _h;
+
+      static void _fire(timer_entry *e) noexcept { static_cast<sleep_awaitable *>(e)->_h.resume(); }
+
+    public:
+      sleep_awaitable(reactor &r, uint64_t ns) noexcept
+          : _wheel(r._timers.get())
+          , _ns(ns)
+      {
+        fire = &_fire;
+      }
+      sleep_awaitable(const sleep_awaitable &) = delete;
+      sleep_awaitable &operator=(const sleep_awaitable &) = delete;
+      // A coroutine destroyed while sleeping cancels its timer
+      ~sleep_awaitable()
+      {
+        if(prev != nullptr)
+        {
+          _wheel->remove(this);
+        }
+      }
+
+      bool await_ready() noexcept { return _ns == 0; }
+      void await_suspend(coroutine_handle<> h) noexcept
+      {
+        _h = h;
+        expiry = _wheel->expiry_after(_ns);
+        _wheel->add(this);
+      }
+      result<void, std::error_code> await_resume() noexcept { return success(); }
+    };
+
+#if OUTCOME_HAVE_NOOP_COROUTINE
+    /* Owns the task of a with_deadline(). When the task completes, it resumes the awaiter
+    of the deadline_awaitable, unless the deadline expired first, in which case it was
+    detached and destroys itself.
+    */
+    template <class Awaitable> class OUTCOME_NODISCARD deadline_child
+    {
+    public:
+      struct promise_type : coroutine_frame_allocation
+      {
+        Awaitable *task;
+        deadline_awaitable<Awaitable> *owner{nullptr};  // null once detached
+        bool completed{false};
+
+        explicit promise_type(Awaitable &t) noexcept
+            : task(&t)
+        {
+        }
+        deadline_child get_return_object() noexcept { return deadline_child(coroutine_handle<promise_type>::from_promise(*this)); }
+        suspend_always initial_suspend() noexcept { return {}; }
+        auto final_suspend() noexcept
+        {
+          struct awaiter
+          {
+            bool await_ready() noexcept { return false; }
+            void await_resume() noexcept {}
+            coroutine_handle<> await_suspend(coroutine_handle<promise_type> self) noexcept
+            {
+              auto &p = self.promise();
+              p.completed = true;
+              if(p.owner == nullptr)
+              {
+                self.destroy();
+                return noop_coroutine();
+              }
+              return p.owner->_task_completed();
+            }
+          };
+          return awaiter{};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+      };
+
+    private:
+      coroutine_handle<promise_type> _h;
+
+      explicit deadline_child(coroutine_handle<promise_type> h) noexcept
+          : _h(h)
+      {
+      }
+
+    public:
+      deadline_child(deadline_child &&o) noexcept
+          : _h(o._h)
+      {
+        o._h = nullptr;
+      }
+      deadline_child(const deadline_child &) = delete;
+      deadline_child &operator=(deadline_child &&) = delete;
+      deadline_child &operator=(const deadline_child &) = delete;
+      ~deadline_child()
+      {
+        if(_h)
+        {
+          _h.destroy();
+        }
+      }
+
+      coroutine_handle<promise_type> handle() const noexcept { return _h; }
+      // Gives up ownership of a child which will destroy itself
+      void detach() noexcept
+      {
+        _h.promise().owner = nullptr;
+        _h = nullptr;
+      }
+    };
+    template <class Awaitable> inline deadline_child<Awaitable> make_deadline_child(Awaitable task) { co_await when_child_awaiter<Awaitable>{task}; }
+
+    /* The awaitable returned by with_deadline(). The task is started when this is awaited,
+    and if it suspends, a timer is added to the reactor. Whichever of the task and the timer
+    finishes first resumes the awaiter. If the timer does, the task is detached and its
+    cancellation requested, which resumes it there and then if it is suspended on I/O, so
+    it completes and destroys itself before the awaiter is resumed. A task suspended on
+    anything else is left to run to completion detached.
+    */
+    template <class Awaitable> class OUTCOME_NODISCARD deadline_awaitable : timer_entry
+    {
+    public:
+      using container_type = typename Awaitable::container_type;
+
+    private:
+      timer_wheel *_wheel;
+      uint64_t _ns;
+      deadline_child<Awaitable> _child;
+      cancellation_source _source;
+      coroutine_handle<> _cont;
+      bool _timed_out;
+
+      static void _fire(timer_entry *e) noexcept
+      {
+        auto *self = static_cast<deadline_awaitable *>(e);
+        self->_timed_out = true;
+        self->_child.detach();
+        self->_source.request_cancellation();
+        self->_cont.resume();
+      }
+
+    public:
+      deadline_awaitable(reactor &r, uint64_t ns, Awaitable task)
+          : _wheel(r._timers.get())
+          , _ns(ns)
+          , _child(make_deadline_child(static_cast<Awaitable &&>(task)))
+          , _timed_out(ns == 0)
+      {
+        fire = &_fire;
+      }
+      deadline_awaitable(const deadline_awaitable &) = delete;
+      deadline_awaitable &operator=(const deadline_awaitable &) = delete;
+      // Destroyed while awaited, the timer is cancelled and the task detached
+      ~deadline_awaitable()
+      {
+        if(prev != nullptr)
+        {
+          _wheel->remove(this);
+          _child.detach();
+        }
+      }
+
+      bool await_ready() noexcept { return _timed_out; }
+      bool await_suspend(coroutine_handle<> h) noexcept
+      {
+        auto &p = _child.handle().promise();
+        inherit_cancellation_token(*p.task, _source.token());  // ADL finds the overload for awaitable
+        p.owner = this;
+        _child.handle().resume();  // runs the task until it first suspends
+        if(p.completed)
+        {
+          return false;
+        }
+        _cont = h;
+        expiry = _wheel->expiry_after(_ns);
+        _wheel->add(this);
+        return true;
+      }
+      container_type await_resume()
+      {
+        if(_timed_out)
+        {
+          return container_type(std::make_error_code(std::errc::timed_out));
+        }
+        return _child.handle().promise().task->await_resume();
+      }
+
+      // Called by the task's owning coroutine when it completes
+      coroutine_handle<> _task_completed() noexcept
+      {
+        if(!_cont)
+        {
+          return noop_coroutine();  // completed synchronously within await_suspend()
+        }
+        _wheel->remove(this);
+        return _cont;
+      }
+    };
+#endif
+  }  // namespace detail
+
+  //! Reads up to `bytes` into `buffer`, returning the bytes read, zero at end of file.
+  inline detail::io_awaitable<detail::read_op> async_read(io_handle &h, void *buffer, size_t bytes) noexcept { return {h._state, detail::read_op{buffer, bytes}}; }
+  //! Writes up to `bytes` from `buffer`, returning the bytes written.
+  inline detail::io_awaitable<detail::write_op> async_write(io_handle &h, const void *buffer, size_t bytes) noexcept { return {h._state, detail::write_op{buffer, bytes}}; }
+  //! Accepts a connection on a listening socket, returning its non-blocking file descriptor.
+  inline detail::io_awaitable<detail::accept_op> async_accept(io_handle &h) noexcept { return {h._state, detail::accept_op{}}; }
+
+  //! Suspends the awaiting coroutine for at least `d`, without blocking the reactor.
+  template <class Rep, class Period> inline detail::sleep_awaitable sleep_for(reactor &r, std::chrono::duration<Rep, Period> d) noexcept
+  {
+    return {r, detail::timeout_ns(std::chrono::duration_cast<std::chrono::nanoseconds>(d))};
+  }
+#if OUTCOME_HAVE_NOOP_COROUTINE
+  //! Runs `task`, returning its result, or `errc::timed_out` if it does not complete within `d`.
+  template <class Cont, class Rep, class Period> inline detail::deadline_awaitable<detail::awaitable<Cont, true, false>> with_deadline(reactor &r, detail::awaitable<Cont, true, false> task, std::chrono::duration<Rep, Period> d)
+  {
+    static_assert(std::is_constructible<Cont, std::error_code>::value, "with_deadline() needs a task whose result can be constructed from a std::error_code");
+    return {r, detail::timeout_ns(std::chrono::duration_cast<std::chrono::nanoseconds>(d)), static_cast<detail::awaitable<Cont, true, false> &&>(task)};
+  }
+#endif
+}  // namespace awaitables
+OUTCOME_V2_NAMESPACE_END
+
+#endif
+
+#endif
@@ -0,0 +1,506 @@
+/* A structure of arrays container of results
+(C) 2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2020
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_RESULT_VECTOR_HPP
+#define OUTCOME_RESULT_VECTOR_HPP
+
+#include "result.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+template <class R, class S, class NoValuePolicy> class basic_result_vector;
+
+namespace detail
+{
+  // Element proxy for basic_result_vector, presenting the observers of basic_result
+  template <class Vector, bool IsConst> class basic_result_vector_reference
+  {
+    friend Vector;
+    template <class, bool> friend class basic_result_vector_reference;
+
+    using _vector_type = std::conditional_t<IsConst, const Vector, Vector>;
+    _vector_type *_v;
+    typename Vector::size_type _idx;
+
+    constexpr basic_result_vector_reference(_vector_type *v, typename Vector::size_type idx) noexcept
+        : _v(v)
+        , _idx(idx)
+    {
+    }
+
+  public:
+    using value_type = typename Vector::value_type;
+    using error_type = typename Vector::error_type;
+    using result_type = typename Vector::result_type;
+
+    basic_result_vector_reference(const basic_result_vector_reference &) = default;
+    //! Implicit conversion from a mutable proxy to a const proxy.
+    OUTCOME_TEMPLATE(bool OtherIsConst)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(IsConst && !OtherIsConst))
+    constexpr basic_result_vector_reference(const basic_result_vector_reference<Vector, OtherIsConst> &o) noexcept  // NOLINT
+        : _v(o._v)
+        , _idx(o._idx)
+    {
+    }
+
+    //! Replaces the element with the state of `o`.
+    OUTCOME_TEMPLATE(bool _IsConst = IsConst)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(!_IsConst))
+    basic_result_vector_reference &operator=(result_type o)
+    {
+      _v->_assign(_idx, static_cast<result_type &&>(o));
+      return *this;
+    }
+    //! Replaces the element with the state of the element referenced by `o`.
+    basic_result_vector_reference &operator=(const basic_result_vector_reference &o)
+    {
+      return *this = static_cast<result_type>(o);
+    }
+
+    //! Returns a copy of the element as a `basic_result`.
+    operator result_type() const { return has_value() ? result_type(in_place_type<value_type>, assume_value()) : result_type(in_place_type<error_type>, assume_error()); }
+
+    bool has_value() const noexcept { return _v->_has_value(_idx); }
+    bool has_error() const noexcept { return !has_value(); }
+    bool has_failure() const noexcept { return !has_value(); }
+    constexpr bool has_exception() const noexcept { return false; }
+    constexpr bool has_lost_consistency() const noexcept { return false; }
+    explicit operator bool() const noexcept { return has_value(); }
+
+    auto &assume_value() const noexcept { return _v->_values[_idx]; }
+    auto &assume_error() const noexcept { return _v->_find_error(_idx)->second; }
+    auto &value() const
+    {
+      if(!has_value())
+      {
+        // Let the no-value policy decide what happens
+        result_type(in_place_type<error_type>, assume_error()).value();
+      }
+      return assume_value();
+    }
+    auto &error() const
+    {
+      if(!has_error())
+      {
+        // Let the no-value policy decide what happens
+        result_type(in_place_type<value_type>).error();
+      }
+      return assume_error();
+    }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+type definition template <class R, class S, class NoValuePolicy> basic_result_vector. Potential doc page: `basic_result_vector<T, E, NoValuePolicy>`
+*/
+template <class R, class S, class NoValuePolicy> class basic_result_vector
+{
+  static_assert(!std::is_void<R>::value && !std::is_void<S>::value, "basic_result_vector cannot store void values or errors");
+  static_assert(std::is_default_constructible<R>::value, "basic_result_vector default constructs the value of each failed element");
+
+  friend class detail::basic_result_vector_reference<basic_result_vector, false>;
+  friend class detail::basic_result_vector_reference<basic_result_vector, true>;
+
+public:
+  using value_type = R;
+  using error_type = S;
+  using no_value_policy_type = NoValuePolicy;
+  using result_type = basic_result<R, S, NoValuePolicy>;
+  using size_type = size_t;
+  using reference = detail::basic_result_vector_reference<basic_result_vector, false>;
+  using const_reference = detail::basic_result_vector_reference<basic_result_vector, true>;
+  //! The sparse error store, one entry per failed element sorted by element index.
+  using error_store_type = std::vector<std::pair<size_type, error_type>>;
+
+  template <bool IsConst> class iterator_impl
+  {
+    friend class basic_result_vector;
+    using _vector_type = std::conditional_t<IsConst, const basic_result_vector, basic_result_vector>;
+    _vector_type *_v{nullptr};
+    size_type _idx{0};
+
+    constexpr iterator_impl(_vector_type *v, size_type idx) noexcept
+        : _v(v)
+        , _idx(idx)
+    {
+    }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = result_type;
+    using difference_type = ptrdiff_t;
+    using reference = detail::basic_result_vector_reference<basic_result_vector, IsConst>;
+    using pointer = void;
+
+    iterator_impl() = default;
+    constexpr reference operator*() const noexcept { return reference(_v, _idx); }
+    constexpr iterator_impl &operator++() noexcept
+    {
+      ++_idx;
+      return *this;
+    }
+    constexpr iterator_impl operator++(int) noexcept
+    {
+      iterator_impl ret(*this);
+      ++_idx;
+      return ret;
+    }
+    constexpr bool operator==(const iterator_impl &o) const noexcept { return _v == o._v && _idx == o._idx; }
+    constexpr bool operator!=(const iterator_impl &o) const noexcept { return !(*this == o); }
+  };
+  using iterator = iterator_impl<false>;
+  using const_iterator = iterator_impl<true>;
+
+private:
+  static constexpr size_type _bits_per_word = 64;
+
+  std::vector<uint64_t> _status;  // one bit per element, set if the element has a value
+  std::vector<value_type> _values;
+  error_store_type _errors;
+
+  bool _has_value(size_type idx) const noexcept { return ((_status[idx / _bits_per_word] >> (idx % _bits_per_word)) & 1) != 0; }
+  void _set_has_value(size_type idx, bool v) noexcept
+  {
+    const uint64_t mask = uint64_t(1) << (idx % _bits_per_word);
+    if(v)
+    {
+      _status[idx / _bits_per_word] |= mask;
+    }
+    else
+    {
+      _status[idx / _bits_per_word] &= ~mask;
+    }
+  }
+  template <class ErrorStore> static auto _lower_bound(ErrorStore &errors, size_type idx) noexcept
+  {
+    return std::lower_bound(errors.begin(), errors.end(), idx, [](const typename error_store_type::value_type &a, size_type b) { return a.first < b; });
+  }
+  auto _find_error(size_type idx) noexcept { return _lower_bound(_errors, idx); }
+  auto _find_error(size_type idx) const noexcept { return _lower_bound(_errors, idx); }
+
+  void _assign(size_type idx, result_type &&o)
+  {
+    auto it = _find_error(idx);
+    if(o.has_value())
+    {
+      _values[idx] = static_cast<result_type &&>(o).assume_value();
+      if(!_has_value(idx))
+      {
+        _errors.erase(it);
+        _set_has_value(idx, true);
+      }
+      return;
+    }
+    if(_has_value(idx))
+    {
+      // Everything which can throw is done before the element changes state, so a throw leaves the container unchanged
+      value_type blank{};
+      it = _errors.emplace(it, idx, static_cast<result_type &&>(o).assume_error());
+      struct _
+      {
+        error_store_type &errors;
+        typename error_store_type::iterator it;
+        bool all_good{false};
+        ~_()
+        {
+          if(!all_good)
+          {
+            errors.erase(it);
+          }
+        }
+      } _{_errors, it};
+      _values[idx] = static_cast<value_type &&>(blank);
+      _.all_good = true;
+      _set_has_value(idx, false);
+      return;
+    }
+    it->second = static_cast<result_type &&>(o).assume_error();
+  }
+  // Ensures the status bitmap has a bit for one more element
+  void _grow()
+  {
+    if(_status.size() * _bits_per_word <= _values.size())
+    {
+      _status.push_back(0);
+    }
+  }
+
+public:
+  //! Default constructor, constructs an empty container.
+  basic_result_vector() = default;
+
+  //! True if the container has no elements.
+  bool empty() const noexcept { return _values.empty(); }
+  //! The number of elements.
+  size_type size() const noexcept { return _values.size(); }
+  //! Reserves storage for `n` elements, and for `errors` failed elements.
+  void reserve(size_type n, size_type errors = 0)
+  {
+    _status.reserve((n + _bits_per_word - 1) / _bits_per_word);
+    _values.reserve(n);
+    _errors.reserve(errors);
+  }
+  //! Removes all elements.
+  void clear() noexcept
+  {
+    _status.clear();
+    _values.clear();
+    _errors.clear();
+  }
+
+  //! Appends a successful element, constructing its value from `args`.
+  template <class... Args> void emplace_value(Args &&... args)
+  {
+    _grow();
+    _values.emplace_back(static_cast<Args &&>(args)...);
+    _set_has_value(_values.size() - 1, true);
+  }
+  //! Appends a failed element, constructing its error from `args`.
+  template <class... Args> void emplace_error(Args &&... args)
+  {
+    _grow();
+    const size_type idx = _values.size();
+    _errors.emplace_back(std::piecewise_construct, std::forward_as_tuple(idx), std::forward_as_tuple(static_cast<Args &&>(args)...));
+    struct _
+    {
+      error_store_type &errors;
+      bool all_good{false};
+      ~_()
+      {
+        if(!all_good)
+        {
+          errors.pop_back();
+        }
+      }
+    } _{_errors};
+    _values.emplace_back();
+    _.all_good = true;
+    _set_has_value(idx, false);
+  }
+  //! Appends an element with the state of `o`.
+  void push_back(result_type o)
+  {
+    if(o.has_value())
+    {
+      emplace_value(static_cast<result_type &&>(o).assume_value());
+    }
+    else
+    {
+      emplace_error(static_cast<result_type &&>(o).assume_error());
+    }
+  }
+  //! Removes the last element.
+  void pop_back() noexcept
+  {
+    const size_type idx = _values.size() - 1;
+    if(!_has_value(idx))
+    {
+      _errors.pop_back();
+    }
+    _set_has_value(idx, false);
+    _values.pop_back();
+    _status.resize((_values.size() + _bits_per_word - 1) / _bits_per_word);
+  }
+
+  //! Returns a proxy for element `idx`, which behaves like a `basic_result`.
+  reference operator[](size_type idx) noexcept { return reference(this, idx); }
+  //! Returns a proxy for element `idx`, which behaves like a `basic_result`.
+  const_reference operator[](size_type idx) const noexcept { return const_reference(this, idx); }
+  reference front() noexcept { return (*this)[0]; }
+  const_reference front() const noexcept { return (*this)[0]; }
+  reference back() noexcept { return (*this)[size() - 1]; }
+  const_reference back() const noexcept { return (*this)[size() - 1]; }
+
+  iterator begin() noexcept { return iterator(this, 0); }
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  iterator end() noexcept { return iterator(this, size()); }
+  const_iterator end() const noexcept { return const_iterator(this, size()); }
+  const_iterator cend() const noexcept { return end(); }
+
+  //! True if every element has a value.
+  bool all_valued() const noexcept { return _errors.empty(); }
+  //! The number of failed elements.
+  size_type count_failed() const noexcept { return _errors.size(); }
+  //! The index of the first failed element, or `size()` if no element failed.
+  size_type first_failed_index() const noexcept { return _errors.empty() ? size() : _errors.front().first; }
+  //! All the values. Failed elements hold a default constructed value.
+  const std::vector<value_type> &values() const noexcept { return _values; }
+  //! All the errors, as pairs of element index and error, sorted by element index.
+  const error_store_type &errors() const noexcept { return _errors; }
+  //! The status bitmap, one bit per element in ascending order within each word, set if the element has a value.
+  const std::vector<uint64_t> &status_bitmap() const noexcept { return _status; }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S = std::error_code, class NoValuePolicy = policy::default_policy<R, S, void>>  //
+using result_vector = basic_result_vector<R, S, NoValuePolicy>;
+
+namespace detail
+{
+  template <class T> using result_status_field_type = std::decay_t<decltype(std::declval<const T &>()._iostreams_state()._status)>;
+
+  // The status bits of the `idx`-th of an array of statuses `stride` bytes apart
+  inline unsigned status_scan_bits(const char *p, size_t stride, size_t idx) noexcept
+  {
+    return static_cast<unsigned>(reinterpret_cast<const status_bitfield_type *>(p + idx * stride)->status_value);
+  }
+  // The status bits common to eight consecutive statuses
+  inline unsigned status_scan_and8(const char *p, size_t stride, size_t idx) noexcept
+  {
+    return (status_scan_bits(p, stride, idx) & status_scan_bits(p, stride, idx + 1) & status_scan_bits(p, stride, idx + 2) & status_scan_bits(p, stride, idx + 3))  //
+           & (status_scan_bits(p, stride, idx + 4) & status_scan_bits(p, stride, idx + 5) & status_scan_bits(p, stride, idx + 6) & status_scan_bits(p, stride, idx + 7));
+  }
+  // The number of eight consecutive statuses with a value
+  inline unsigned status_scan_valued8(const char *p, size_t stride, size_t idx) noexcept
+  {
+    static constexpr unsigned have_value = static_cast<unsigned>(status::have_value);
+    return ((status_scan_bits(p, stride, idx) & have_value) + (status_scan_bits(p, stride, idx + 1) & have_value) + (status_scan_bits(p, stride, idx + 2) & have_value)
+            + (status_scan_bits(p, stride, idx + 3) & have_value))  //
+           + ((status_scan_bits(p, stride, idx + 4) & have_value) + (status_scan_bits(p, stride, idx + 5) & have_value) + (status_scan_bits(p, stride, idx + 6) & have_value)
+              + (status_scan_bits(p, stride, idx + 7) & have_value));
+  }
+
+  /* Scans for the first of `count` statuses `stride` bytes apart without a value, returning its
+  index or `count`. Eight statuses are loaded independently of one another and combined, with a
+  single branch per eight, so a scan of mostly successful results is bound by memory rather than
+  by one load and branch after another. A gather of eight statuses was measured to be no faster
+  than this, and assembling SIMD lanes from strided loads to be much slower.
+  */
+  inline size_t status_scan_first_failed(const char *p, size_t stride, size_t count) noexcept
+  {
+    static constexpr unsigned have_value = static_cast<unsigned>(status::have_value);
+    size_t idx = 0;
+    for(; idx + 8 <= count; idx += 8)
+    {
+      if((status_scan_and8(p, stride, idx) & have_value) == 0)
+      {
+        break;
+      }
+    }
+    for(; idx < count; idx++)
+    {
+      if((status_scan_bits(p, stride, idx) & have_value) == 0)
+      {
+        return idx;
+      }
+    }
+    return count;
+  }
+  // Counts the statuses without a value, as per status_scan_first_failed()
+  inline size_t status_scan_count_failed(const char *p, size_t stride, size_t count) noexcept
+  {
+    static constexpr unsigned have_value = static_cast<unsigned>(status::have_value);
+    size_t ret = 0, idx = 0;
+    for(; idx + 8 <= count; idx += 8)
+    {
+      ret += 8 - status_scan_valued8(p, stride, idx);
+    }
+    for(; idx < count; idx++)
+    {
+      ret += static_cast<size_t>((status_scan_bits(p, stride, idx) & have_value) ^ have_value);
+    }
+    return ret;
+  }
+
+  // Results whose status is encoded into a niche of the value or error are tested using has_value()
+  template <class T, bool = std::is_same<result_status_field_type<T>, status_bitfield_type>::value> struct result_status_scan
+  {
+    static size_t first_failed(const T *first, size_t count) noexcept
+    {
+      for(size_t idx = 0; idx < count; idx++)
+      {
+        if(!first[idx].has_value())
+        {
+          return idx;
+        }
+      }
+      return count;
+    }
+    static size_t count_failed(const T *first, size_t count) noexcept
+    {
+      size_t ret = 0;
+      for(size_t idx = 0; idx < count; idx++)
+      {
+        ret += static_cast<size_t>(!first[idx].has_value());
+      }
+      return ret;
+    }
+  };
+  template <class T> struct result_status_scan<T, true>
+  {
+    static const char *status_of(const T *first) noexcept { return reinterpret_cast<const char *>(&first->_iostreams_state()._status); }
+    static size_t first_failed(const T *first, size_t count) noexcept { return (count == 0) ? 0 : status_scan_first_failed(status_of(first), sizeof(T), count); }
+    static size_t count_failed(const T *first, size_t count) noexcept { return (count == 0) ? 0 : status_scan_count_failed(status_of(first), sizeof(T), count); }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class NoValuePolicy> inline size_t first_failed_index(const basic_result<R, S, NoValuePolicy> *first, size_t count) noexcept
+{
+  return detail::result_status_scan<basic_result<R, S, NoValuePolicy>>::first_failed(first, count);
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class NoValuePolicy> inline size_t count_failed(const basic_result<R, S, NoValuePolicy> *first, size_t count) noexcept
+{
+  return detail::result_status_scan<basic_result<R, S, NoValuePolicy>>::count_failed(first, count);
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class NoValuePolicy> inline bool all_valued(const basic_result<R, S, NoValuePolicy> *first, size_t count) noexcept
+{
+  return first_failed_index(first, count) == count;
+}
+
+//! Overloads for contiguous ranges of results, such as `std::vector` and `std::array`.
+template <class Range> inline auto first_failed_index(const Range &r) noexcept -> decltype(first_failed_index(r.data(), r.size()))
+{
+  return first_failed_index(r.data(), r.size());
+}
+template <class Range> inline auto count_failed(const Range &r) noexcept -> decltype(count_failed(r.data(), r.size()))
+{
+  return count_failed(r.data(), r.size());
+}
+template <class Range> inline auto all_valued(const Range &r) noexcept -> decltype(all_valued(r.data(), r.size()))
+{
+  return all_valued(r.data(), r.size());
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
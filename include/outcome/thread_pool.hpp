@@ -0,0 +1,431 @@
+/* A work stealing thread pool for Outcome's awaitables
+(C) 2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2020
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_THREAD_POOL_HPP
+#define OUTCOME_THREAD_POOL_HPP
+
+#include "detail/coroutine_awaitables.hpp"
+
+#if defined(OUTCOME_FOUND_COROUTINE_HEADER) && OUTCOME_HAVE_NOOP_COROUTINE
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+namespace awaitables
+{
+  namespace detail
+  {
+    /* The Chase-Lev work stealing deque, as corrected for weak memory models by
+    Lê, Pop, Cohen and Zappa Nardelli (2013). Only the owning thread may push and take,
+    any thread may steal. Arrays outgrown are kept until the deque is destroyed, as
+    thieves may still be reading them.
+    */
+    class work_stealing_deque
+    {
+      struct array
+      {
+        const int64_t size;  // a power of two
+        std::unique_ptr<std::atomic<void *>[]> items;
+        std::unique_ptr<array> previous;
+
+        explicit array(int64_t _size)
+            : size(_size)
+            , items(new std::atomic<void *>[static_cast<size_t>(_size)])
+        {
+        }
+        void *get(int64_t i) const noexcept { return items[static_cast<size_t>(i & (size - 1))].load(std::memory_order_relaxed); }
+        void put(int64_t i, void *v) noexcept { items[static_cast<size_t>(i & (size - 1))].store(v, std::memory_order_relaxed); }
+      };
+
+      alignas(64) std::atomic<int64_t> _top{0};
+      alignas(64) std::atomic<int64_t> _bottom{0};
+      std::atomic<array *> _array;
+      std::unique_ptr<array> _owned;
+
+    public:
+      explicit work_stealing_deque(int64_t size = 256)
+          : _array(new array(size))
+      {
+        _owned.reset(_array.load(std::memory_order_relaxed));
+      }
+      work_stealing_deque(const work_stealing_deque &) = delete;
+      work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+
+      //! Owner only. Pushes onto the bottom.
+      void push(void *v)
+      {
+        const int64_t b = _bottom.load(std::memory_order_relaxed);
+        const int64_t t = _top.load(std::memory_order_acquire);
+        array *a = _array.load(std::memory_order_relaxed);
+        if(b - t > a->size - 1)
+        {
+          auto *grown = new array(a->size * 2);  // could throw
+          for(int64_t i = t; i < b; i++)
+          {
+            grown->put(i, a->get(i));
+          }
+          grown->previous = std::move(_owned);
+          _owned.reset(grown);
+          _array.store(grown, std::memory_order_release);
+          a = grown;
+        }
+        a->put(b, v);
+        // A release store rather than a release fence, which sanitisers understand
+        _bottom.store(b + 1, std::memory_order_release);
+      }
+      //! Owner only. Takes from the bottom, returning null if empty.
+      void *take() noexcept
+      {
+        const int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+        array *a = _array.load(std::memory_order_relaxed);
+        _bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = _top.load(std::memory_order_relaxed);
+        void *ret = nullptr;
+        if(t <= b)
+        {
+          ret = a->get(b);
+          if(t == b)
+          {
+            // The last item, race any thieves for it
+            if(!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+              ret = nullptr;
+            }
+            _bottom.store(b + 1, std::memory_order_relaxed);
+          }
+        }
+        else
+        {
+          _bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return ret;
+      }
+      //! Any thread. Steals from the top, returning null if empty or if another thief won.
+      void *steal() noexcept
+      {
+        int64_t t = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = _bottom.load(std::memory_order_acquire);
+        if(t < b)
+        {
+          array *a = _array.load(std::memory_order_acquire);
+          void *ret = a->get(t);
+          if(!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+          {
+            return nullptr;
+          }
+          return ret;
+        }
+        return nullptr;
+      }
+      //! Any thread. A hint as to whether there is anything to steal.
+      bool empty() const noexcept { return _bottom.load(std::memory_order_acquire) <= _top.load(std::memory_order_acquire); }
+    };
+
+    /* Owns a task spawned onto an executor. The task runs within a coroutine which
+    hands its completion to whoever awaits this, or destroys itself if this was
+    destroyed first.
+    */
+    template <class Awaitable> class OUTCOME_NODISCARD spawned_awaitable
+    {
+    public:
+      using container_type = typename Awaitable::container_type;
+
+      struct promise_type : coroutine_frame_allocation
+      {
+        Awaitable *task;
+        std::atomic<void *> waiter{nullptr};  // null while running, else the awaiter, completed_state() or detached_state()
+
+        explicit promise_type(Awaitable &t) noexcept
+            : task(&t)
+        {
+        }
+        spawned_awaitable get_return_object() noexcept { return spawned_awaitable(coroutine_handle<promise_type>::from_promise(*this)); }
+        suspend_always initial_suspend() noexcept { return {}; }
+        auto final_suspend() noexcept
+        {
+          struct awaiter
+          {
+            bool await_ready() noexcept { return false; }
+            void await_resume() noexcept {}
+            coroutine_handle<> await_suspend(coroutine_handle<promise_type> self) noexcept
+            {
+              void *w = self.promise().waiter.exchange(completed_state(), std::memory_order_acq_rel);
+              if(w == detached_state())
+              {
+                self.destroy();
+                return noop_coroutine();
+              }
+              return (w != nullptr) ? coroutine_handle<>::from_address(w) : noop_coroutine();
+            }
+          };
+          return awaiter{};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+      };
+
+    private:
+      coroutine_handle<promise_type> _h;
+
+      explicit spawned_awaitable(coroutine_handle<promise_type> h) noexcept
+          : _h(h)
+      {
+      }
+
+    public:
+      spawned_awaitable(spawned_awaitable &&o) noexcept
+          : _h(o._h)
+      {
+        o._h = nullptr;
+      }
+      spawned_awaitable(const spawned_awaitable &) = delete;
+      spawned_awaitable &operator=(spawned_awaitable &&) = delete;
+      spawned_awaitable &operator=(const spawned_awaitable &) = delete;
+      ~spawned_awaitable()
+      {
+        if(_h)
+        {
+          void *expected = nullptr;
+          if(!_h.promise().waiter.compare_exchange_strong(expected, detached_state(), std::memory_order_acq_rel))
+          {
+            _h.destroy();  // completed
+          }
+        }
+      }
+
+      //! The coroutine to resume to start the task.
+      coroutine_handle<> handle() const noexcept { return _h; }
+
+      bool await_ready() noexcept { return _h.promise().waiter.load(std::memory_order_acquire) == completed_state(); }
+      bool await_suspend(coroutine_handle<> cont) noexcept
+      {
+        void *expected = nullptr;
+        return _h.promise().waiter.compare_exchange_strong(expected, cont.address(), std::memory_order_acq_rel);
+      }
+      container_type await_resume() { return _h.promise().task->await_resume(); }
+    };
+    template <class Awaitable> inline spawned_awaitable<Awaitable> make_spawned_awaitable(Awaitable task) { co_await when_child_awaiter<Awaitable>{task}; }
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  thread_pool. Potential doc page: `thread_pool`
+*/
+  class thread_pool
+  {
+    struct worker
+    {
+      detail::work_stealing_deque queue;
+      std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<worker>> _workers;
+    // Coroutines scheduled from threads not in the pool
+    std::mutex _lock;
+    std::condition_variable _cond;
+    std::deque<void *> _injected;
+    std::atomic<size_t> _injected_count{0};
+    // Bumped whenever work is added, so workers going to sleep do not miss it
+    std::atomic<uint64_t> _epoch{0};
+    std::atomic<size_t> _sleeping{0};
+    std::atomic<bool> _stopping{false};
+
+    struct current_worker
+    {
+      thread_pool *pool;
+      size_t index;
+    };
+    static current_worker &_current() noexcept
+    {
+      static thread_local current_worker v{nullptr, 0};
+      return v;
+    }
+
+    void _wake() noexcept
+    {
+      _epoch.fetch_add(1, std::memory_order_seq_cst);
+      if(_sleeping.load(std::memory_order_seq_cst) > 0)
+      {
+        std::lock_guard<std::mutex> g(_lock);
+        _cond.notify_one();
+      }
+    }
+    void *_take_injected()
+    {
+      if(_injected_count.load(std::memory_order_acquire) == 0)
+      {
+        return nullptr;
+      }
+      std::lock_guard<std::mutex> g(_lock);
+      if(_injected.empty())
+      {
+        return nullptr;
+      }
+      void *ret = _injected.front();
+      _injected.pop_front();
+      _injected_count.fetch_sub(1, std::memory_order_release);
+      return ret;
+    }
+    void *_find_work(size_t index, uint32_t &rng)
+    {
+      if(void *ret = _workers[index]->queue.take())
+      {
+        return ret;
+      }
+      if(void *ret = _take_injected())
+      {
+        return ret;
+      }
+      // Steal from the other workers, starting at a random one
+      const size_t count = _workers.size();
+      rng ^= rng << 13;
+      rng ^= rng >> 17;
+      rng ^= rng << 5;
+      for(size_t n = 0, start = rng % count; n < count; n++)
+      {
+        const size_t victim = (start + n) % count;
+        if(victim != index)
+        {
+          if(void *ret = _workers[victim]->queue.steal())
+          {
+            return ret;
+          }
+        }
+      }
+      return nullptr;
+    }
+    void _run(size_t index)
+    {
+      _current() = {this, index};
+      uint32_t rng = static_cast<uint32_t>(index) * 2654435761U + 1;
+      for(;;)
+      {
+        const uint64_t epoch = _epoch.load(std::memory_order_seq_cst);
+        if(void *h = _find_work(index, rng))
+        {
+          coroutine_handle<>::from_address(h).resume();
+          continue;
+        }
+        if(_stopping.load(std::memory_order_acquire))
+        {
+          break;
+        }
+        std::unique_lock<std::mutex> g(_lock);
+        _sleeping.fetch_add(1, std::memory_order_seq_cst);
+        _cond.wait(g, [&] { return _epoch.load(std::memory_order_seq_cst) != epoch || _stopping.load(std::memory_order_acquire); });
+        _sleeping.fetch_sub(1, std::memory_order_seq_cst);
+      }
+      _current() = {nullptr, 0};
+    }
+
+  public:
+    //! Starts `threads` worker threads, by default one per hardware thread.
+    explicit thread_pool(size_t threads = std::thread::hardware_concurrency())
+    {
+      if(threads == 0)
+      {
+        threads = 1;
+      }
+      _workers.reserve(threads);
+      for(size_t n = 0; n < threads; n++)
+      {
+        _workers.push_back(std::make_unique<worker>());
+      }
+      for(size_t n = 0; n < threads; n++)
+      {
+        _workers[n]->thread = std::thread([this, n] { _run(n); });
+      }
+    }
+    thread_pool(const thread_pool &) = delete;
+    thread_pool(thread_pool &&) = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+    thread_pool &operator=(thread_pool &&) = delete;
+    //! Runs all scheduled work to completion, then joins the worker threads.
+    ~thread_pool()
+    {
+      {
+        std::lock_guard<std::mutex> g(_lock);
+        _stopping.store(true, std::memory_order_release);
+        _cond.notify_all();
+      }
+      for(auto &w : _workers)
+      {
+        w->thread.join();
+      }
+    }
+
+    //! The number of worker threads.
+    size_t size() const noexcept { return _workers.size(); }
+
+    //! Resumes `h` on a worker thread. From a worker of this pool, this does not lock.
+    void submit(coroutine_handle<> h)
+    {
+      current_worker &c = _current();
+      if(c.pool == this)
+      {
+        _workers[c.index]->queue.push(h.address());
+      }
+      else
+      {
+        std::lock_guard<std::mutex> g(_lock);
+        _injected.push_back(h.address());
+        _injected_count.fetch_add(1, std::memory_order_release);
+      }
+      _wake();
+    }
+
+    //! An awaitable which resumes the awaiting coroutine on a worker thread.
+    auto schedule() noexcept
+    {
+      struct awaiter
+      {
+        thread_pool *pool;
+        bool await_ready() noexcept { return false; }
+        void await_suspend(coroutine_handle<> h) { pool->submit(h); }
+        void await_resume() noexcept {}
+      };
+      return awaiter{this};
+    }
+
+    //! Starts `task` on a worker thread, returning an awaitable for its result.
+    template <class Cont> detail::spawned_awaitable<detail::awaitable<Cont, true, true>> spawn(detail::awaitable<Cont, true, true> task)
+    {
+      auto ret = detail::make_spawned_awaitable(static_cast<detail::awaitable<Cont, true, true> &&>(task));
+      submit(ret.handle());
+      return ret;
+    }
+  };
+}  // namespace awaitables
+OUTCOME_V2_NAMESPACE_END
+
+#endif
+
+#endif
@@ -53,6 +53,22 @@ type definition  is_error_type. Potential doc page: NOT FOUND
     static constexpr bool value = false;
   };
 
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  is_trivially_relocatable. Potential doc page: NOT FOUND
+*/
+  template <class T> struct is_trivially_relocatable
+  {
+    static constexpr bool value = std::is_trivially_copyable<T>::value || is_move_bitcopying<T>::value;
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  niche. Potential doc page: NOT FOUND
+*/
+  template <class T> struct niche
+  {
+    static constexpr bool value = false;
+  };
+
   /*! AWAITING HUGO JSON CONVERSION TOOL
 type definition  is_error_type. Potential doc page: NOT FOUND
 */
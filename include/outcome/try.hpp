@@ -29,11 +29,19 @@ Distributed under the Boost Software License, Version 1.0.
 
 OUTCOME_V2_NAMESPACE_BEGIN
 
+template <class R, class S, class NoValuePolicy>  //
+class basic_result;
+template <class R, class S, class P, class NoValuePolicy>  //
+class basic_outcome;
+
 namespace detail
 {
   struct has_value_overload
   {
   };
+  struct forward_failure_overload
+  {
+  };
   struct as_failure_overload
   {
   };
@@ -73,6 +81,69 @@ namespace detail
   OUTCOME_TREQUIRES(OUTCOME_TEXPR(std::declval<T>().value()))
   constexpr inline bool has_value(int /*unused */) { return true; }
   template <class T> constexpr inline bool has_value(...) { return false; }
+
+  // The inputs to TRY which can construct the caller's return type directly from their error
+  template <class T> struct is_failure_forwarding_source
+  {
+    static constexpr bool value = false;
+  };
+  template <class R, class S, class NoValuePolicy> struct is_failure_forwarding_source<basic_result<R, S, NoValuePolicy>>
+  {
+    static constexpr bool value = !std::is_void<S>::value;
+  };
+  // The return types which TRY can construct directly from the error of its input
+  template <class T> struct is_failure_forwarding_target
+  {
+    static constexpr bool value = false;
+  };
+  template <class R, class S, class NoValuePolicy> struct is_failure_forwarding_target<basic_result<R, S, NoValuePolicy>>
+  {
+    static constexpr bool value = true;
+  };
+  template <class R, class S, class P, class NoValuePolicy> struct is_failure_forwarding_target<basic_outcome<R, S, P, NoValuePolicy>>
+  {
+    static constexpr bool value = true;
+  };
+  OUTCOME_TEMPLATE(class T, class R)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(is_failure_forwarding_target<R>::value), OUTCOME_TEXPR(std::declval<T>().template _forward_failure<R>()))
+  constexpr inline bool can_forward_failure(int /*unused */) { return true; }
+  template <class T, class R> constexpr inline bool can_forward_failure(...) { return false; }
+
+  /* Returned by TRY for a failed `basic_result` input. Converts into whatever the
+  function doing the TRY returns. If that is a `basic_result` or `basic_outcome` which can be constructed
+  in place from the input's error, the error is moved from the input straight into the return value,
+  otherwise the return value is constructed from the input's `as_failure()` as before.
+  */
+  template <class T> class OUTCOME_NODISCARD forwarded_failure
+  {
+    T &&_v;
+
+  public:
+    using failure_type = decltype(std::declval<T>().as_failure());
+
+    constexpr explicit forwarded_failure(T &&v) noexcept
+        : _v(static_cast<T &&>(v))
+    {
+    }
+    forwarded_failure(const forwarded_failure &) = delete;
+    forwarded_failure(forwarded_failure &&) = default;  // NOLINT
+    forwarded_failure &operator=(const forwarded_failure &) = delete;
+    forwarded_failure &operator=(forwarded_failure &&) = delete;
+    ~forwarded_failure() = default;
+
+    OUTCOME_TEMPLATE(class R)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_convertible<failure_type, R>::value && can_forward_failure<T, R>(5)))
+    constexpr operator R() &&  // NOLINT
+    {
+      return static_cast<T &&>(_v).template _forward_failure<R>();
+    }
+    OUTCOME_TEMPLATE(class R)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_convertible<failure_type, R>::value && !can_forward_failure<T, R>(5)))
+    constexpr operator R() &&  // NOLINT
+    {
+      return static_cast<T &&>(_v).as_failure();
+    }
+  };
 }  // namespace detail
 
 /*! AWAITING HUGO JSON CONVERSION TOOL
@@ -85,6 +156,38 @@ constexpr inline bool try_operation_has_value(T &&v, detail::has_value_overload
   return v.has_value();
 }
 
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class... Args> constexpr inline bool try_operation_has_all_values(const Args &... vs)
+{
+  // Combined with & rather than && so there is one branch for all the inputs, not one per input
+  unsigned ret = 1;
+  using expand = int[];
+  (void) expand{0, (ret &= static_cast<unsigned>(::OUTCOME_V2_NAMESPACE::try_operation_has_value(vs)), 0)...};
+  return ret != 0;
+}
+
+namespace detail
+{
+  /* Wraps the input of a failed TRY before it is passed to `try_operation_return_as()`. A `basic_result`
+  becomes a `forwarded_failure`, which `try_operation_return_as()` returns as is, so its error can be
+  forwarded straight into the return value. Anything else is passed on unchanged, so still reaches the
+  `try_operation_return_as()` overloads visible where the TRY is.
+  */
+  OUTCOME_TEMPLATE(class T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(is_failure_forwarding_source<std::decay_t<T>>::value))
+  constexpr inline forwarded_failure<T> try_operation_forward_failure(T &&v) noexcept { return forwarded_failure<T>(static_cast<T &&>(v)); }
+  OUTCOME_TEMPLATE(class T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(!is_failure_forwarding_source<std::decay_t<T>>::value))
+  constexpr inline T &&try_operation_forward_failure(T &&v) noexcept { return static_cast<T &&>(v); }
+}  // namespace detail
+
+//! Passes on the failure of a `basic_result` which TRY forwards into its return value.
+template <class T> constexpr inline detail::forwarded_failure<T> try_operation_return_as(detail::forwarded_failure<T> &&v, detail::forward_failure_overload = {}) noexcept
+{
+  return static_cast<detail::forwarded_failure<T> &&>(v);
+}
 /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
@@ -132,6 +235,31 @@ constexpr inline decltype(auto) try_operation_extract_value(T &&v, detail::value
   return static_cast<T &&>(v).value();
 }
 
+namespace detail
+{
+  // The last input is returned without being tested, as the caller guarantees that at least one input failed
+  template <class R, class T> constexpr inline R try_operation_return_first_failure(T &&v)
+  {
+    return ::OUTCOME_V2_NAMESPACE::try_operation_return_as(try_operation_forward_failure(static_cast<T &&>(v)));
+  }
+  template <class R, class T, class U, class... Args> constexpr inline R try_operation_return_first_failure(T &&v, U &&u, Args &&... vs)
+  {
+    if(!::OUTCOME_V2_NAMESPACE::try_operation_has_value(v))
+    {
+      return ::OUTCOME_V2_NAMESPACE::try_operation_return_as(try_operation_forward_failure(static_cast<T &&>(v)));
+    }
+    return try_operation_return_first_failure<R>(static_cast<U &&>(u), static_cast<Args &&>(vs)...);
+  }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class T, class... Args> constexpr inline R try_operation_return_first_failure(T &&v, Args &&... vs)
+{
+  return detail::try_operation_return_first_failure<R>(static_cast<T &&>(v), static_cast<Args &&>(vs)...);
+}
+
 OUTCOME_V2_NAMESPACE_END
 
 #if !defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 8
@@ -174,6 +302,10 @@ OUTCOME_V2_NAMESPACE_END
 #endif
 #endif
 
+// The failure of a TRY, with the error of a basic_result forwarded straight into the return value
+#define OUTCOME_TRYV2_RETURN_AS(unique)                                                                                                                        \
+  ::OUTCOME_V2_NAMESPACE::try_operation_return_as(::OUTCOME_V2_NAMESPACE::detail::try_operation_forward_failure(static_cast<decltype(unique) &&>(unique)))
+
 #define OUTCOME_TRYV2_UNIQUE_STORAGE_UNPACK(...) __VA_ARGS__
 #define OUTCOME_TRYV2_UNIQUE_STORAGE_DEDUCE3(unique, ...) auto unique = (__VA_ARGS__)
 #define OUTCOME_TRYV2_UNIQUE_STORAGE_DEDUCE2(x) x
@@ -192,11 +324,11 @@ OUTCOME_V2_NAMESPACE_END
 #define OUTCOME_TRYV2_SUCCESS_LIKELY(unique, retstmt, spec, ...)                                                                                               \
   OUTCOME_TRYV2_UNIQUE_STORAGE(unique, spec, __VA_ARGS__);                                                                                                     \
   OUTCOME_TRY_LIKELY_IF(::OUTCOME_V2_NAMESPACE::try_operation_has_value(unique));                                                                                \
-  else retstmt ::OUTCOME_V2_NAMESPACE::try_operation_return_as(static_cast<decltype(unique) &&>(unique))
+  else retstmt OUTCOME_TRYV2_RETURN_AS(unique)
 #define OUTCOME_TRYV3_FAILURE_LIKELY(unique, retstmt, spec, ...)                                                                                               \
   OUTCOME_TRYV2_UNIQUE_STORAGE(unique, spec, __VA_ARGS__);                                                                                                     \
   OUTCOME_TRY_LIKELY_IF(!OUTCOME_V2_NAMESPACE::try_operation_has_value(unique))                                                                                \
-  retstmt ::OUTCOME_V2_NAMESPACE::try_operation_return_as(static_cast<decltype(unique) &&>(unique))
+  retstmt OUTCOME_TRYV2_RETURN_AS(unique)
 
 #define OUTCOME_TRY2_VAR_SECOND2(x, var) var
 #define OUTCOME_TRY2_VAR_SECOND3(x, y, ...) x y
@@ -342,6 +474,200 @@ SIGNATURE NOT RECOGNISED
 #define OUTCOME_CO_TRY_FAILURE_LIKELY(...) OUTCOME_TRY_CALL_OVERLOAD(OUTCOME_CO_TRY_FAILURE_LIKELY_INVOKE_TRY, __VA_ARGS__)
 
 
+// Each group is either (expr) or (var, expr), the latter as for OUTCOME_TRY(var, expr)
+#define OUTCOME_TRY_ALL_KIND3(_1_, _2_, _3_, _4_, _5_, _6_, _7_, _8_, kind, ...) kind
+#define OUTCOME_TRY_ALL_KIND2(args) OUTCOME_TRY_ALL_KIND3 args
+#define OUTCOME_TRY_ALL_KIND(...) OUTCOME_TRY_ALL_KIND2((__VA_ARGS__, VAR, VAR, VAR, VAR, VAR, VAR, VAR, EXPR, EXPR))
+#define OUTCOME_TRY_ALL_APPLY(macro, args) macro args
+#define OUTCOME_TRY_ALL_STORE_EXPR(unique, ...) auto unique = (__VA_ARGS__)
+#define OUTCOME_TRY_ALL_STORE_VAR(unique, var, ...) OUTCOME_TRYV2_UNIQUE_STORAGE(unique, var, __VA_ARGS__)
+#define OUTCOME_TRY_ALL_STORE(unique, group)                                                                                                                   \
+  OUTCOME_TRY_ALL_APPLY(OUTCOME_TRY_GLUE(OUTCOME_TRY_ALL_STORE_, OUTCOME_TRY_ALL_KIND group), (unique, OUTCOME_TRYV2_UNIQUE_STORAGE_UNPACK group))
+#define OUTCOME_TRY_ALL_VALUE_EXPR(unique, ...)
+#define OUTCOME_TRY_ALL_VALUE_VAR(unique, var, ...)                                                                                                            \
+  OUTCOME_TRY2_VAR(var) = ::OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(unique) &&>(unique))
+#define OUTCOME_TRY_ALL_VALUE(unique, group)                                                                                                                   \
+  OUTCOME_TRY_ALL_APPLY(OUTCOME_TRY_GLUE(OUTCOME_TRY_ALL_VALUE_, OUTCOME_TRY_ALL_KIND group), (unique, OUTCOME_TRYV2_UNIQUE_STORAGE_UNPACK group))
+// Combined with & rather than && so there is one branch for all the inputs, not one per input
+#define OUTCOME_TRY_ALL_HAS_VALUE(unique) static_cast<unsigned>(::OUTCOME_V2_NAMESPACE::try_operation_has_value(unique))
+#define OUTCOME_TRY_ALL_RETURN_IF_FAILED(unique, retstmt)                                                                                                      \
+  if(!::OUTCOME_V2_NAMESPACE::try_operation_has_value(unique))                                                                                                 \
+  retstmt OUTCOME_TRYV2_RETURN_AS(unique)
+
+#define OUTCOME_TRY_ALL_STORES1(unique, g1) OUTCOME_TRY_ALL_STORE(OUTCOME_TRY_GLUE(unique, _1), g1)
+#define OUTCOME_TRY_ALL_STORES2(unique, g1, g2)                                                                                                                \
+  OUTCOME_TRY_ALL_STORES1(unique, g1);                                                                                                                         \
+  OUTCOME_TRY_ALL_STORE(OUTCOME_TRY_GLUE(unique, _2), g2)
+#define OUTCOME_TRY_ALL_STORES3(unique, g1, g2, g3)                                                                                                            \
+  OUTCOME_TRY_ALL_STORES2(unique, g1, g2);                                                                                                                     \
+  OUTCOME_TRY_ALL_STORE(OUTCOME_TRY_GLUE(unique, _3), g3)
+#define OUTCOME_TRY_ALL_STORES4(unique, g1, g2, g3, g4)                                                                                                        \
+  OUTCOME_TRY_ALL_STORES3(unique, g1, g2, g3);                                                                                                                 \
+  OUTCOME_TRY_ALL_STORE(OUTCOME_TRY_GLUE(unique, _4), g4)
+#define OUTCOME_TRY_ALL_STORES5(unique, g1, g2, g3, g4, g5)                                                                                                    \
+  OUTCOME_TRY_ALL_STORES4(unique, g1, g2, g3, g4);                                                                                                             \
+  OUTCOME_TRY_ALL_STORE(OUTCOME_TRY_GLUE(unique, _5), g5)
+#define OUTCOME_TRY_ALL_STORES6(unique, g1, g2, g3, g4, g5, g6)                                                                                                \
+  OUTCOME_TRY_ALL_STORES5(unique, g1, g2, g3, g4, g5);                                                                                                         \
+  OUTCOME_TRY_ALL_STORE(OUTCOME_TRY_GLUE(unique, _6), g6)
+#define OUTCOME_TRY_ALL_STORES7(unique, g1, g2, g3, g4, g5, g6, g7)                                                                                            \
+  OUTCOME_TRY_ALL_STORES6(unique, g1, g2, g3, g4, g5, g6);                                                                                                     \
+  OUTCOME_TRY_ALL_STORE(OUTCOME_TRY_GLUE(unique, _7), g7)
+#define OUTCOME_TRY_ALL_STORES8(unique, g1, g2, g3, g4, g5, g6, g7, g8)                                                                                        \
+  OUTCOME_TRY_ALL_STORES7(unique, g1, g2, g3, g4, g5, g6, g7);                                                                                                 \
+  OUTCOME_TRY_ALL_STORE(OUTCOME_TRY_GLUE(unique, _8), g8)
+#define OUTCOME_TRY_ALL_VALUES1(unique, g1) OUTCOME_TRY_ALL_VALUE(OUTCOME_TRY_GLUE(unique, _1), g1)
+#define OUTCOME_TRY_ALL_VALUES2(unique, g1, g2)                                                                                                                \
+  OUTCOME_TRY_ALL_VALUES1(unique, g1);                                                                                                                         \
+  OUTCOME_TRY_ALL_VALUE(OUTCOME_TRY_GLUE(unique, _2), g2)
+#define OUTCOME_TRY_ALL_VALUES3(unique, g1, g2, g3)                                                                                                            \
+  OUTCOME_TRY_ALL_VALUES2(unique, g1, g2);                                                                                                                     \
+  OUTCOME_TRY_ALL_VALUE(OUTCOME_TRY_GLUE(unique, _3), g3)
+#define OUTCOME_TRY_ALL_VALUES4(unique, g1, g2, g3, g4)                                                                                                        \
+  OUTCOME_TRY_ALL_VALUES3(unique, g1, g2, g3);                                                                                                                 \
+  OUTCOME_TRY_ALL_VALUE(OUTCOME_TRY_GLUE(unique, _4), g4)
+#define OUTCOME_TRY_ALL_VALUES5(unique, g1, g2, g3, g4, g5)                                                                                                    \
+  OUTCOME_TRY_ALL_VALUES4(unique, g1, g2, g3, g4);                                                                                                             \
+  OUTCOME_TRY_ALL_VALUE(OUTCOME_TRY_GLUE(unique, _5), g5)
+#define OUTCOME_TRY_ALL_VALUES6(unique, g1, g2, g3, g4, g5, g6)                                                                                                \
+  OUTCOME_TRY_ALL_VALUES5(unique, g1, g2, g3, g4, g5);                                                                                                         \
+  OUTCOME_TRY_ALL_VALUE(OUTCOME_TRY_GLUE(unique, _6), g6)
+#define OUTCOME_TRY_ALL_VALUES7(unique, g1, g2, g3, g4, g5, g6, g7)                                                                                            \
+  OUTCOME_TRY_ALL_VALUES6(unique, g1, g2, g3, g4, g5, g6);                                                                                                     \
+  OUTCOME_TRY_ALL_VALUE(OUTCOME_TRY_GLUE(unique, _7), g7)
+#define OUTCOME_TRY_ALL_VALUES8(unique, g1, g2, g3, g4, g5, g6, g7, g8)                                                                                        \
+  OUTCOME_TRY_ALL_VALUES7(unique, g1, g2, g3, g4, g5, g6, g7);                                                                                                 \
+  OUTCOME_TRY_ALL_VALUE(OUTCOME_TRY_GLUE(unique, _8), g8)
+#define OUTCOME_TRY_ALL_HAS_VALUES1(unique) OUTCOME_TRY_ALL_HAS_VALUE(OUTCOME_TRY_GLUE(unique, _1))
+#define OUTCOME_TRY_ALL_HAS_VALUES2(unique) OUTCOME_TRY_ALL_HAS_VALUES1(unique) & OUTCOME_TRY_ALL_HAS_VALUE(OUTCOME_TRY_GLUE(unique, _2))
+#define OUTCOME_TRY_ALL_HAS_VALUES3(unique) OUTCOME_TRY_ALL_HAS_VALUES2(unique) & OUTCOME_TRY_ALL_HAS_VALUE(OUTCOME_TRY_GLUE(unique, _3))
+#define OUTCOME_TRY_ALL_HAS_VALUES4(unique) OUTCOME_TRY_ALL_HAS_VALUES3(unique) & OUTCOME_TRY_ALL_HAS_VALUE(OUTCOME_TRY_GLUE(unique, _4))
+#define OUTCOME_TRY_ALL_HAS_VALUES5(unique) OUTCOME_TRY_ALL_HAS_VALUES4(unique) & OUTCOME_TRY_ALL_HAS_VALUE(OUTCOME_TRY_GLUE(unique, _5))
+#define OUTCOME_TRY_ALL_HAS_VALUES6(unique) OUTCOME_TRY_ALL_HAS_VALUES5(unique) & OUTCOME_TRY_ALL_HAS_VALUE(OUTCOME_TRY_GLUE(unique, _6))
+#define OUTCOME_TRY_ALL_HAS_VALUES7(unique) OUTCOME_TRY_ALL_HAS_VALUES6(unique) & OUTCOME_TRY_ALL_HAS_VALUE(OUTCOME_TRY_GLUE(unique, _7))
+#define OUTCOME_TRY_ALL_HAS_VALUES8(unique) OUTCOME_TRY_ALL_HAS_VALUES7(unique) & OUTCOME_TRY_ALL_HAS_VALUE(OUTCOME_TRY_GLUE(unique, _8))
+// Returns the first failure, so the last input must have failed if none before it did
+#define OUTCOME_TRY_ALL_RETURNS1(unique, retstmt) retstmt OUTCOME_TRYV2_RETURN_AS(OUTCOME_TRY_GLUE(unique, _1))
+#define OUTCOME_TRY_ALL_RETURNS2(unique, retstmt)                                                                                                              \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _1), retstmt);                                                                                     \
+  retstmt OUTCOME_TRYV2_RETURN_AS(OUTCOME_TRY_GLUE(unique, _2))
+#define OUTCOME_TRY_ALL_RETURNS3(unique, retstmt)                                                                                                              \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _1), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _2), retstmt);                                                                                     \
+  retstmt OUTCOME_TRYV2_RETURN_AS(OUTCOME_TRY_GLUE(unique, _3))
+#define OUTCOME_TRY_ALL_RETURNS4(unique, retstmt)                                                                                                              \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _1), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _2), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _3), retstmt);                                                                                     \
+  retstmt OUTCOME_TRYV2_RETURN_AS(OUTCOME_TRY_GLUE(unique, _4))
+#define OUTCOME_TRY_ALL_RETURNS5(unique, retstmt)                                                                                                              \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _1), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _2), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _3), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _4), retstmt);                                                                                     \
+  retstmt OUTCOME_TRYV2_RETURN_AS(OUTCOME_TRY_GLUE(unique, _5))
+#define OUTCOME_TRY_ALL_RETURNS6(unique, retstmt)                                                                                                              \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _1), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _2), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _3), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _4), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _5), retstmt);                                                                                     \
+  retstmt OUTCOME_TRYV2_RETURN_AS(OUTCOME_TRY_GLUE(unique, _6))
+#define OUTCOME_TRY_ALL_RETURNS7(unique, retstmt)                                                                                                              \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _1), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _2), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _3), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _4), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _5), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _6), retstmt);                                                                                     \
+  retstmt OUTCOME_TRYV2_RETURN_AS(OUTCOME_TRY_GLUE(unique, _7))
+#define OUTCOME_TRY_ALL_RETURNS8(unique, retstmt)                                                                                                              \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _1), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _2), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _3), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _4), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _5), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _6), retstmt);                                                                                     \
+  OUTCOME_TRY_ALL_RETURN_IF_FAILED(OUTCOME_TRY_GLUE(unique, _7), retstmt);                                                                                     \
+  retstmt OUTCOME_TRYV2_RETURN_AS(OUTCOME_TRY_GLUE(unique, _8))
+
+#define OUTCOME_TRY_ALL_INVOKE1(unique, retstmt, g1)                                                                                                           \
+  OUTCOME_TRY_ALL_STORES1(unique, g1);                                                                                                                         \
+  OUTCOME_TRY_LIKELY_IF(OUTCOME_TRY_ALL_HAS_VALUES1(unique));                                                                                                  \
+  else                                                                                                                                                         \
+  {                                                                                                                                                            \
+    OUTCOME_TRY_ALL_RETURNS1(unique, retstmt);                                                                                                                 \
+  }                                                                                                                                                            \
+  OUTCOME_TRY_ALL_VALUES1(unique, g1)
+#define OUTCOME_TRY_ALL_INVOKE2(unique, retstmt, g1, g2)                                                                                                       \
+  OUTCOME_TRY_ALL_STORES2(unique, g1, g2);                                                                                                                     \
+  OUTCOME_TRY_LIKELY_IF(OUTCOME_TRY_ALL_HAS_VALUES2(unique));                                                                                                  \
+  else                                                                                                                                                         \
+  {                                                                                                                                                            \
+    OUTCOME_TRY_ALL_RETURNS2(unique, retstmt);                                                                                                                 \
+  }                                                                                                                                                            \
+  OUTCOME_TRY_ALL_VALUES2(unique, g1, g2)
+#define OUTCOME_TRY_ALL_INVOKE3(unique, retstmt, g1, g2, g3)                                                                                                   \
+  OUTCOME_TRY_ALL_STORES3(unique, g1, g2, g3);                                                                                                                 \
+  OUTCOME_TRY_LIKELY_IF(OUTCOME_TRY_ALL_HAS_VALUES3(unique));                                                                                                  \
+  else                                                                                                                                                         \
+  {                                                                                                                                                            \
+    OUTCOME_TRY_ALL_RETURNS3(unique, retstmt);                                                                                                                 \
+  }                                                                                                                                                            \
+  OUTCOME_TRY_ALL_VALUES3(unique, g1, g2, g3)
+#define OUTCOME_TRY_ALL_INVOKE4(unique, retstmt, g1, g2, g3, g4)                                                                                               \
+  OUTCOME_TRY_ALL_STORES4(unique, g1, g2, g3, g4);                                                                                                             \
+  OUTCOME_TRY_LIKELY_IF(OUTCOME_TRY_ALL_HAS_VALUES4(unique));                                                                                                  \
+  else                                                                                                                                                         \
+  {                                                                                                                                                            \
+    OUTCOME_TRY_ALL_RETURNS4(unique, retstmt);                                                                                                                 \
+  }                                                                                                                                                            \
+  OUTCOME_TRY_ALL_VALUES4(unique, g1, g2, g3, g4)
+#define OUTCOME_TRY_ALL_INVOKE5(unique, retstmt, g1, g2, g3, g4, g5)                                                                                           \
+  OUTCOME_TRY_ALL_STORES5(unique, g1, g2, g3, g4, g5);                                                                                                         \
+  OUTCOME_TRY_LIKELY_IF(OUTCOME_TRY_ALL_HAS_VALUES5(unique));                                                                                                  \
+  else                                                                                                                                                         \
+  {                                                                                                                                                            \
+    OUTCOME_TRY_ALL_RETURNS5(unique, retstmt);                                                                                                                 \
+  }                                                                                                                                                            \
+  OUTCOME_TRY_ALL_VALUES5(unique, g1, g2, g3, g4, g5)
+#define OUTCOME_TRY_ALL_INVOKE6(unique, retstmt, g1, g2, g3, g4, g5, g6)                                                                                       \
+  OUTCOME_TRY_ALL_STORES6(unique, g1, g2, g3, g4, g5, g6);                                                                                                     \
+  OUTCOME_TRY_LIKELY_IF(OUTCOME_TRY_ALL_HAS_VALUES6(unique));                                                                                                  \
+  else                                                                                                                                                         \
+  {                                                                                                                                                            \
+    OUTCOME_TRY_ALL_RETURNS6(unique, retstmt);                                                                                                                 \
+  }                                                                                                                                                            \
+  OUTCOME_TRY_ALL_VALUES6(unique, g1, g2, g3, g4, g5, g6)
+#define OUTCOME_TRY_ALL_INVOKE7(unique, retstmt, g1, g2, g3, g4, g5, g6, g7)                                                                                   \
+  OUTCOME_TRY_ALL_STORES7(unique, g1, g2, g3, g4, g5, g6, g7);                                                                                                 \
+  OUTCOME_TRY_LIKELY_IF(OUTCOME_TRY_ALL_HAS_VALUES7(unique));                                                                                                  \
+  else                                                                                                                                                         \
+  {                                                                                                                                                            \
+    OUTCOME_TRY_ALL_RETURNS7(unique, retstmt);                                                                                                                 \
+  }                                                                                                                                                            \
+  OUTCOME_TRY_ALL_VALUES7(unique, g1, g2, g3, g4, g5, g6, g7)
+#define OUTCOME_TRY_ALL_INVOKE8(unique, retstmt, g1, g2, g3, g4, g5, g6, g7, g8)                                                                               \
+  OUTCOME_TRY_ALL_STORES8(unique, g1, g2, g3, g4, g5, g6, g7, g8);                                                                                             \
+  OUTCOME_TRY_LIKELY_IF(OUTCOME_TRY_ALL_HAS_VALUES8(unique));                                                                                                  \
+  else                                                                                                                                                         \
+  {                                                                                                                                                            \
+    OUTCOME_TRY_ALL_RETURNS8(unique, retstmt);                                                                                                                 \
+  }                                                                                                                                                            \
+  OUTCOME_TRY_ALL_VALUES8(unique, g1, g2, g3, g4, g5, g6, g7, g8)
+#define OUTCOME_TRY_ALL2(unique, retstmt, ...)                                                                                                                 \
+  OUTCOME_TRY_OVERLOAD_GLUE(OUTCOME_TRY_OVERLOAD_MACRO(OUTCOME_TRY_ALL_INVOKE, OUTCOME_TRY_COUNT_ARGS_MAX8(__VA_ARGS__)), (unique, retstmt, __VA_ARGS__))
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_TRY_ALL(...) OUTCOME_TRY_ALL2(OUTCOME_TRY_UNIQUE_NAME, return, __VA_ARGS__)
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define OUTCOME_CO_TRY_ALL(...) OUTCOME_TRY_ALL2(OUTCOME_TRY_UNIQUE_NAME, co_return, __VA_ARGS__)
+
+
 /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
@@ -27,13 +27,246 @@ Distributed under the Boost Software License, Version 1.0.
 
 #include "config.hpp"
 
+#include <atomic>
 #include <exception>
+#include <mutex>
+#include <new>  // for bad_alloc
+#include <stdexcept>
 #include <string>
 #include <system_error>
+#include <typeinfo>
 
 OUTCOME_V2_NAMESPACE_BEGIN
 
 #ifdef __cpp_exceptions
+// On the Itanium C++ ABI with libstdc++, we can match an exception_ptr against a type exactly
+// as a catch clause would, without rethrowing it
+#if !defined(OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_INFO) && defined(__GLIBCXX__) && defined(__GXX_RTTI)
+#define OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_INFO 1
+#endif
+#ifndef OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_INFO
+#define OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_INFO 0
+#endif
+
+namespace detail
+{
+  using exception_classifier_fn = void (*)();
+
+  // One exception type, and how to convert it into an error code
+  struct exception_classifier
+  {
+#if OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_INFO
+    const std::type_info *type;
+    std::error_code (*classify)(exception_classifier_fn, const void *);
+#endif
+    bool (*classify_by_rethrow)(exception_classifier_fn, const std::exception_ptr &, std::error_code &);
+    exception_classifier_fn fn;
+  };
+  template <class E> inline exception_classifier make_exception_classifier(std::error_code (*fn)(const E &)) noexcept
+  {
+    using fn_type = std::error_code (*)(const E &);
+    struct _
+    {
+#if OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_INFO
+      static std::error_code classify(exception_classifier_fn f, const void *e) { return reinterpret_cast<fn_type>(f)(*static_cast<const E *>(e)); }
+#endif
+      static bool classify_by_rethrow(exception_classifier_fn f, const std::exception_ptr &ep, std::error_code &ec)
+      {
+        try
+        {
+          std::rethrow_exception(ep);
+        }
+        catch(const E &e)
+        {
+          ec = reinterpret_cast<fn_type>(f)(e);
+          return true;
+        }
+        catch(...)
+        {
+        }
+        return false;
+      }
+    };
+#if OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_INFO
+    return {&typeid(E), &_::classify, &_::classify_by_rethrow, reinterpret_cast<exception_classifier_fn>(fn)};
+#else
+    return {&_::classify_by_rethrow, reinterpret_cast<exception_classifier_fn>(fn)};
+#endif
+  }
+
+#if !OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_INFO
+  inline bool classify_standard_exception(const std::exception_ptr &ep, std::error_code &ec)
+  {
+    try
+    {
+      std::rethrow_exception(ep);
+    }
+    catch(const std::invalid_argument & /*unused*/)
+    {
+      ec = std::make_error_code(std::errc::invalid_argument);
+    }
+    catch(const std::domain_error & /*unused*/)
+    {
+      ec = std::make_error_code(std::errc::argument_out_of_domain);
+    }
+    catch(const std::length_error & /*unused*/)
+    {
+      ec = std::make_error_code(std::errc::argument_list_too_long);
+    }
+    catch(const std::out_of_range & /*unused*/)
+    {
+      ec = std::make_error_code(std::errc::result_out_of_range);
+    }
+    catch(const std::logic_error & /*unused*/) /* base class for this group */
+    {
+      ec = std::make_error_code(std::errc::invalid_argument);
+    }
+    catch(const std::system_error &e) /* also catches ios::failure */
+    {
+      ec = e.code();
+    }
+    catch(const std::overflow_error & /*unused*/)
+    {
+      ec = std::make_error_code(std::errc::value_too_large);
+    }
+    catch(const std::range_error & /*unused*/)
+    {
+      ec = std::make_error_code(std::errc::result_out_of_range);
+    }
+    catch(const std::runtime_error & /*unused*/) /* base class for this group */
+    {
+      ec = std::make_error_code(std::errc::resource_unavailable_try_again);
+    }
+    catch(const std::bad_alloc & /*unused*/)
+    {
+      ec = std::make_error_code(std::errc::not_enough_memory);
+    }
+    catch(...)
+    {
+      return false;
+    }
+    return true;
+  }
+#endif
+
+  /* The classifiers used by error_from_exception(). User registered types are searched
+  first, most recently registered first. Then the standard exception types are searched in
+  the same order as catch clauses would match them, using either classifiers at the front
+  of the table or a single rethrow.
+  */
+  class exception_classifier_registry
+  {
+    static constexpr size_t _max_entries = 64;
+    std::mutex _lock;
+    exception_classifier _entries[_max_entries]{};
+    size_t _builtins{0};
+    std::atomic<size_t> _count{0};
+
+    template <class E> void _add_builtin(std::error_code (*fn)(const E &)) noexcept
+    {
+      _entries[_builtins++] = make_exception_classifier<E>(fn);
+    }
+
+    exception_classifier_registry()
+    {
+#if OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_INFO
+      // clang-format off
+      _add_builtin<std::invalid_argument>([](const std::invalid_argument & /*unused*/) { return std::make_error_code(std::errc::invalid_argument); });
+      _add_builtin<std::domain_error>([](const std::domain_error & /*unused*/) { return std::make_error_code(std::errc::argument_out_of_domain); });
+      _add_builtin<std::length_error>([](const std::length_error & /*unused*/) { return std::make_error_code(std::errc::argument_list_too_long); });
+      _add_builtin<std::out_of_range>([](const std::out_of_range & /*unused*/) { return std::make_error_code(std::errc::result_out_of_range); });
+      _add_builtin<std::logic_error>([](const std::logic_error & /*unused*/) { return std::make_error_code(std::errc::invalid_argument); });  /* base class for this group */
+      _add_builtin<std::system_error>([](const std::system_error &e) { return e.code(); });  /* also catches ios::failure */
+      _add_builtin<std::overflow_error>([](const std::overflow_error & /*unused*/) { return std::make_error_code(std::errc::value_too_large); });
+      _add_builtin<std::range_error>([](const std::range_error & /*unused*/) { return std::make_error_code(std::errc::result_out_of_range); });
+      _add_builtin<std::runtime_error>([](const std::runtime_error & /*unused*/) { return std::make_error_code(std::errc::resource_unavailable_try_again); });  /* base class for this group */
+      _add_builtin<std::bad_alloc>([](const std::bad_alloc & /*unused*/) { return std::make_error_code(std::errc::not_enough_memory); });
+      // clang-format on
+#endif
+      _count.store(_builtins, std::memory_order_release);
+    }
+
+#if OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_INFO
+    static bool _classify(const exception_classifier &c, const std::type_info *thrown_type, void *thrown_object, std::error_code &ec)
+    {
+      // Same test as a catch clause for the classifier's type
+      if(c.type->__do_catch(thrown_type, &thrown_object, 1))
+      {
+        ec = c.classify(c.fn, thrown_object);
+        return true;
+      }
+      return false;
+    }
+#endif
+    static bool _classify(const exception_classifier &c, const std::exception_ptr &ep, std::error_code &ec) { return c.classify_by_rethrow(c.fn, ep, ec); }
+
+    template <class... Args> bool _search(std::error_code &ec, Args... args) const
+    {
+      const size_t count = _count.load(std::memory_order_acquire);
+      for(size_t n = count; n > _builtins; n--)
+      {
+        if(_classify(_entries[n - 1], args..., ec))
+        {
+          return true;
+        }
+      }
+#if OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_INFO
+      for(size_t n = 0; n < _builtins; n++)
+      {
+        if(_classify(_entries[n], args..., ec))
+        {
+          return true;
+        }
+      }
+      return false;
+#else
+      // Rethrowing once into a cascade of catch clauses is cheaper than rethrowing per type
+      return classify_standard_exception(args..., ec);
+#endif
+    }
+
+  public:
+    static exception_classifier_registry &get() noexcept
+    {
+      static exception_classifier_registry v;
+      return v;
+    }
+    bool add(exception_classifier c) noexcept
+    {
+      std::lock_guard<std::mutex> g(_lock);
+      const size_t count = _count.load(std::memory_order_relaxed);
+      if(count == _max_entries)
+      {
+        return false;
+      }
+      _entries[count] = c;
+      _count.store(count + 1, std::memory_order_release);
+      return true;
+    }
+    bool classify(const std::exception_ptr &ep, std::error_code &ec) const
+    {
+#if OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_INFO
+      const std::type_info *thrown_type = ep.__cxa_exception_type();
+      // libstdc++'s exception_ptr is a pointer to the thrown object
+      void *thrown_object = *reinterpret_cast<void *const *>(&ep);  // NOLINT
+      if(thrown_type != nullptr && thrown_object != nullptr)
+      {
+        return _search(ec, thrown_type, thrown_object);
+      }
+#endif
+      return _search(ec, ep);
+    }
+  };
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class E> inline bool register_error_from_exception(std::error_code (*classify)(const E &)) noexcept
+{
+  return detail::exception_classifier_registry::get().add(detail::make_exception_classifier<E>(classify));
+}
+
 /*! AWAITING HUGO JSON CONVERSION TOOL 
 SIGNATURE NOT RECOGNISED
 */
@@ -43,62 +276,18 @@ inline std::error_code error_from_exception(std::exception_ptr &&ep = std::curre
   {
     return {};
   }
+  std::error_code ret;
   try
   {
-    std::rethrow_exception(ep);
-  }
-  catch(const std::invalid_argument & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::invalid_argument);
-  }
-  catch(const std::domain_error & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::argument_out_of_domain);
-  }
-  catch(const std::length_error & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::argument_list_too_long);
-  }
-  catch(const std::out_of_range & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::result_out_of_range);
-  }
-  catch(const std::logic_error & /*unused*/) /* base class for this group */
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::invalid_argument);
-  }
-  catch(const std::system_error &e) /* also catches ios::failure */
-  {
-    ep = std::exception_ptr();
-    return e.code();
-  }
-  catch(const std::overflow_error & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::value_too_large);
-  }
-  catch(const std::range_error & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::result_out_of_range);
-  }
-  catch(const std::runtime_error & /*unused*/) /* base class for this group */
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::resource_unavailable_try_again);
-  }
-  catch(const std::bad_alloc & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::not_enough_memory);
+    if(detail::exception_classifier_registry::get().classify(ep, ret))
+    {
+      ep = std::exception_ptr();
+      return ret;
+    }
   }
   catch(...)
   {
+    // A user supplied classifier threw
   }
   return not_matched;
 }
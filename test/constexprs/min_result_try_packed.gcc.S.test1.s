@@ -0,0 +1,31 @@
+    11c0:	48 83 ec 10          	subq   $0x10,%rsp
+    11a0:	8b 05 5e 0e 00 00    	movl   0xe5e(%rip),%eax        # 2004 <_IO_stdin_used+0x4>
+    11a6:	c6 44 24 f8 01       	movb   $0x1,-0x8(%rsp)
+    11ab:	89 44 24 fa          	movl   %eax,-0x6(%rsp)
+    11af:	48 8b 44 24 f8       	movq   -0x8(%rsp),%rax
+    11b4:	c3                   	retq
+    11b5:	66 66 2e 0f 1f 84 00 	data16 cs nopw 0x0(%rax,%rax,1)
+    11c9:	48 89 04 24          	movq   %rax,(%rsp)
+    11cd:	a9 00 00 01 00       	testl  $0x10000,%eax
+    11d2:	74 2c                	je     1200 <test1()+0x40>
+    11d4:	c7 05 46 2e 00 00 00 	movl   $0x0,0x2e46(%rip)        # 4024 <foo>
+    11de:	0f b7 04 24          	movzwl (%rsp),%eax
+    11e2:	83 c0 01             	addl   $0x1,%eax
+    11e5:	66 89 44 24 08       	movw   %ax,0x8(%rsp)
+    11ea:	8b 05 18 0e 00 00    	movl   0xe18(%rip),%eax        # 2008 <_IO_stdin_used+0x8>
+    11f0:	89 44 24 0a          	movl   %eax,0xa(%rsp)
+    11f4:	48 8b 44 24 08       	movq   0x8(%rsp),%rax
+    11f9:	48 83 c4 10          	addq   $0x10,%rsp
+    11fd:	c3                   	retq
+    11fe:	66 90                	xchgw  %ax,%ax
+    1200:	0f b7 44 24 04       	movzwl 0x4(%rsp),%eax
+    1205:	0f b6 14 24          	movzbl (%rsp),%edx
+    1209:	c1 e0 10             	shll   $0x10,%eax
+    120c:	88 54 24 08          	movb   %dl,0x8(%rsp)
+    1210:	83 c8 02             	orl    $0x2,%eax
+    1213:	89 44 24 0a          	movl   %eax,0xa(%rsp)
+    1217:	48 8b 44 24 08       	movq   0x8(%rsp),%rax
+    121c:	48 83 c4 10          	addq   $0x10,%rsp
+    1220:	c3                   	retq
+    1221:	66 66 2e 0f 1f 84 00 	data16 cs nopw 0x0(%rax,%rax,1)
+    122c:	0f 1f 40 00          	nopl   0x0(%rax)
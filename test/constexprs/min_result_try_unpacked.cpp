@@ -0,0 +1,62 @@
+/* Canned codegen quality test sequences
+(C) 2017-2019 Niall Douglas <http://www.nedproductions.biz/> (9 commits)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+
+#include <cstdint>
+
+extern int foo;
+int foo;
+
+using namespace OUTCOME_V2_NAMESPACE;
+
+// Six bytes, which is returned in a register only after being assembled on the stack unless padded
+enum class code : int8_t
+{
+  bad = 1
+};
+using small_result = result<int16_t, code, policy::terminate>;
+static_assert(sizeof(small_result) == 6, "small_result is not six bytes");
+
+extern QUICKCPPLIB_NOINLINE small_result src1() noexcept
+{
+  return code::bad;
+}
+
+extern QUICKCPPLIB_NOINLINE small_result test1() noexcept
+{
+  OUTCOME_TRY(auto &&v, src1());
+  foo = 0;
+  return static_cast<int16_t>(v + 1);
+}
+extern QUICKCPPLIB_NOINLINE void test2()
+{
+}
+
+int main(void)
+{
+  int ret=0;
+  if(test1()) ret=1;
+  test2();
+  return ret;
+}
@@ -0,0 +1,34 @@
+    11c0:	48 83 ec 10          	subq   $0x10,%rsp
+    11a0:	8b 05 5e 0e 00 00    	movl   0xe5e(%rip),%eax        # 2004 <_IO_stdin_used+0x4>
+    11a6:	c6 44 24 f8 01       	movb   $0x1,-0x8(%rsp)
+    11ab:	89 44 24 fa          	movl   %eax,-0x6(%rsp)
+    11af:	0f b7 54 24 fc       	movzwl -0x4(%rsp),%edx
+    11b4:	8b 44 24 f8          	movl   -0x8(%rsp),%eax
+    11b8:	48 c1 e2 20          	shlq   $0x20,%rdx
+    11bc:	48 09 d0             	orq    %rdx,%rax
+    11bf:	c3                   	retq
+    11c9:	48 89 c2             	movq   %rax,%rdx
+    11cc:	66 89 44 24 0a       	movw   %ax,0xa(%rsp)
+    11d1:	48 c1 ea 20          	shrq   $0x20,%rdx
+    11d5:	66 89 54 24 0e       	movw   %dx,0xe(%rsp)
+    11da:	a9 00 00 01 00       	testl  $0x10000,%eax
+    11df:	74 37                	je     1218 <test1()+0x58>
+    11e1:	c7 05 39 2e 00 00 00 	movl   $0x0,0x2e39(%rip)        # 4024 <foo>
+    11eb:	83 c0 01             	addl   $0x1,%eax
+    11ee:	66 89 44 24 04       	movw   %ax,0x4(%rsp)
+    11f3:	8b 05 0f 0e 00 00    	movl   0xe0f(%rip),%eax        # 2008 <_IO_stdin_used+0x8>
+    11f9:	89 44 24 06          	movl   %eax,0x6(%rsp)
+    11fd:	0f b7 54 24 08       	movzwl 0x8(%rsp),%edx
+    1202:	8b 44 24 04          	movl   0x4(%rsp),%eax
+    1206:	48 83 c4 10          	addq   $0x10,%rsp
+    120a:	48 c1 e2 20          	shlq   $0x20,%rdx
+    120e:	48 09 d0             	orq    %rdx,%rax
+    1211:	c3                   	retq
+    1212:	66 0f 1f 44 00 00    	nopw   0x0(%rax,%rax,1)
+    1218:	0f b7 c2             	movzwl %dx,%eax
+    121b:	0f b6 54 24 0a       	movzbl 0xa(%rsp),%edx
+    1220:	c1 e0 10             	shll   $0x10,%eax
+    1223:	88 54 24 04          	movb   %dl,0x4(%rsp)
+    1227:	83 c8 02             	orl    $0x2,%eax
+    122a:	eb cd                	jmp    11f9 <test1()+0x39>
+    122c:	0f 1f 40 00          	nopl   0x0(%rax)
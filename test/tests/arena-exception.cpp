@@ -0,0 +1,158 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/arena_exception.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <stdexcept>
+
+namespace arena_exception_test
+{
+  static int live;
+
+  struct tracked_error : std::runtime_error
+  {
+    explicit tracked_error(const char *msg)
+        : std::runtime_error(msg)
+    {
+      ++live;
+    }
+    tracked_error(const tracked_error &o)
+        : std::runtime_error(o)
+    {
+      ++live;
+    }
+    ~tracked_error() override { --live; }
+  };
+}  // namespace arena_exception_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / arena_exception, "Tests that outcome works with exceptions allocated from an arena")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using arena_exception_test::live;
+  using arena_exception_test::tracked_error;
+  using outcome_type = outcome<int, std::error_code, arena_exception_ptr>;
+
+  static_assert(std::is_trivially_copyable<arena_exception_ptr>::value, "arena_exception_ptr is not trivially copyable");
+  static_assert(trait::is_exception_ptr_available<arena_exception_ptr>::value, "arena_exception_ptr is not an exception pointer");
+  static_assert(std::is_trivially_copyable<outcome_type>::value, "outcome with arena_exception_ptr is not trivially copyable");
+
+  alignas(std::max_align_t) char buffer[256];
+  {
+    exception_arena arena(buffer, sizeof(buffer));
+    outcome_type a(make_arena_exception(tracked_error("hello"), arena));
+    BOOST_CHECK(live == 1);
+    BOOST_CHECK(arena.size() == 1U);
+    BOOST_CHECK(a.has_exception());
+    // Copies share the arena allocated exception
+    outcome_type b(a);
+    BOOST_CHECK(b.exception() == a.exception());
+    BOOST_CHECK(live == 1);
+    // Overflowing the buffer chains heap blocks
+    for(int n = 0; n < 20; n++)
+    {
+      make_arena_exception(tracked_error("overflow"), arena);
+    }
+    BOOST_CHECK(live == 21);
+    BOOST_CHECK(arena.size() == 21U);
+#ifdef __cpp_exceptions
+    // Crossing a boundary converts to std::exception_ptr
+    std::exception_ptr f = b.failure();
+    try
+    {
+      std::rethrow_exception(f);
+    }
+    catch(const tracked_error &e)
+    {
+      BOOST_CHECK(!strcmp(e.what(), "hello"));
+    }
+    try
+    {
+      b.value();
+      BOOST_CHECK(false);
+    }
+    catch(const tracked_error &e)
+    {
+      BOOST_CHECK(!strcmp(e.what(), "hello"));
+    }
+    f = nullptr;
+#endif
+    BOOST_CHECK(live == 21);
+    // Released in bulk
+    arena.release();
+    BOOST_CHECK(live == 0);
+    BOOST_CHECK(arena.size() == 0U);
+  }
+  {
+    exception_arena arena;
+    exception_arena::scope s(arena);
+    BOOST_CHECK(&exception_arena::current() == &arena);
+    // Errors are converted to exceptions captured into the current arena
+    outcome_type a(std::make_error_code(std::errc::invalid_argument));
+    arena_exception_ptr e = a.failure();
+    (void) e;
+#ifdef __cpp_exceptions
+    BOOST_CHECK(!!e);
+    BOOST_CHECK(arena.size() == 1U);
+    try
+    {
+      std::rethrow_exception(e);
+    }
+    catch(const std::system_error &ex)
+    {
+      BOOST_CHECK(ex.code() == std::errc::invalid_argument);
+    }
+#endif
+  }
+  BOOST_CHECK(&exception_arena::current() != nullptr);
+  {
+    // The thread local arena grows rather than destroying exceptions which are still referred to
+    exception_arena &arena = exception_arena::current();
+    arena.release();
+    outcome_type keep(make_arena_exception(tracked_error("kept")));
+    for(int n = 0; n < 5000; n++)
+    {
+      outcome_type o(std::make_exception_ptr(tracked_error("more")));
+      BOOST_CHECK(o.has_exception());
+    }
+    BOOST_CHECK(arena.size() == 5001U);
+    BOOST_CHECK(arena.heap_bytes() > 64U * 1024U);
+    BOOST_CHECK(live == 5001);
+#ifdef __cpp_exceptions
+    try
+    {
+      std::rethrow_exception(keep.exception().to_exception_ptr());
+    }
+    catch(const tracked_error &e)
+    {
+      BOOST_CHECK(!strcmp(e.what(), "kept"));
+    }
+#endif
+    // Until released by the caller
+    arena.release();
+    BOOST_CHECK(arena.size() == 0U);
+    BOOST_CHECK(arena.heap_bytes() == 0U);
+    BOOST_CHECK(live == 0);
+  }
+}
@@ -0,0 +1,101 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/cold_error.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+
+namespace cold_error_test
+{
+  struct failure_info
+  {
+    std::error_code ec;
+    std::string path1{}, path2{};
+  };
+  inline const std::error_code &make_error_code(const failure_info &fi) { return fi.ec; }
+  inline void outcome_throw_as_system_error_with_payload(failure_info fi) { OUTCOME_THROW_EXCEPTION(std::system_error(fi.ec, fi.path1)); }
+
+  template <class T> using result = OUTCOME_V2_NAMESPACE::result<T, OUTCOME_V2_NAMESPACE::cold_error<failure_info>>;
+
+  inline result<size_t> write_file(bool fail)
+  {
+    if(fail)
+    {
+      return failure_info{make_error_code(std::errc::no_space_on_device), "somepath"};
+    }
+    return 5;
+  }
+}  // namespace cold_error_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / cold_error, "Tests that cold_error keeps large error payloads out of line")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using cold_error_test::failure_info;
+  using cold_error_test::result;
+  using cold_error_test::write_file;
+
+  static_assert(sizeof(cold_error<failure_info>) == sizeof(void *), "cold_error is not pointer sized");
+  static_assert(sizeof(result<size_t>) < sizeof(OUTCOME_V2_NAMESPACE::result<size_t, failure_info>), "result is not smaller");
+  static_assert(trait::is_error_code_available<cold_error<failure_info>>::value, "cold_error<failure_info> is not an error code");
+  static_assert(!trait::is_error_code_available<cold_error<std::string>>::value, "cold_error<std::string> is an error code");
+  static_assert(trait::is_trivially_relocatable<result<size_t>>::value, "result is not trivially relocatable");
+
+  auto a = write_file(false);
+  BOOST_CHECK(a.value() == 5U);
+  auto b = write_file(true);
+  BOOST_REQUIRE(b.has_error());  // NOLINT
+  BOOST_CHECK(b.error()->ec == std::errc::no_space_on_device);
+  BOOST_CHECK(b.error()->path1 == "somepath");
+  BOOST_CHECK(make_error_code(b.error()) == std::errc::no_space_on_device);
+#ifdef __cpp_exceptions
+  try
+  {
+    b.value();
+    BOOST_CHECK(false);
+  }
+  catch(const std::system_error &e)
+  {
+    BOOST_CHECK(e.code() == std::errc::no_space_on_device);
+  }
+#endif
+
+  // Copies are deep, moves transfer ownership
+  auto c(b);
+  BOOST_CHECK(c.error().get() != b.error().get());
+  BOOST_CHECK(c.error()->path1 == "somepath");
+  const failure_info *p = c.error().get();
+  auto d(std::move(c));
+  BOOST_CHECK(d.error().get() == p);
+  BOOST_CHECK(!c.error());
+  d = a;
+  BOOST_CHECK(d.value() == 5U);
+
+  // Freed blocks are reused by the next failure on this thread
+  const failure_info *q = b.error().get();
+  b = a;
+  auto e = write_file(true);
+  BOOST_CHECK(e.error().get() == q);
+  BOOST_CHECK(e.error()->path1 == "somepath");
+}
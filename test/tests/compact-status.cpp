@@ -0,0 +1,78 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#define OUTCOME_ENABLE_COMPACT_STATUS 1
+#include "../../include/outcome.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstdint>
+
+namespace compact_status
+{
+  enum class code : int8_t
+  {
+    bad = 6
+  };
+  template <class T> using result = OUTCOME_V2_NAMESPACE::result<T, code, OUTCOME_V2_NAMESPACE::policy::terminate>;
+
+  inline result<int16_t> src(bool fail)
+  {
+    if(fail)
+    {
+      return code::bad;
+    }
+    return int16_t(5);
+  }
+  inline result<int16_t> dest(bool fail)
+  {
+    OUTCOME_TRY(auto v, src(fail));
+    return int16_t(v + 1);
+  }
+}  // namespace compact_status
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / compact_status, "Tests that the compact status is one byte and drops spare storage")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using compact_status::code;
+  using compact_status::result;
+
+  static_assert(sizeof(result<int16_t>) == 4, "result<int16_t> is not 4 bytes");
+  static_assert(sizeof(result<int8_t>) == 2, "result<int8_t> is not 2 bytes");
+  static_assert(sizeof(result<void>) == 2, "result<void> is not 2 bytes");
+  static_assert(std::is_trivially_copyable<result<int16_t>>::value, "result<int16_t> is not trivially copyable");
+
+  result<int16_t> a(int16_t(5)), b(code::bad);
+  BOOST_CHECK(a.value() == 5);
+  BOOST_CHECK(b.error() == code::bad);
+  BOOST_CHECK(compact_status::dest(false).value() == 6);
+  BOOST_CHECK(compact_status::dest(true).error() == code::bad);
+
+  // There is nowhere to keep spare storage
+  hooks::set_spare_storage(&b, 78);
+  BOOST_CHECK(hooks::spare_storage(&b) == 0);
+  BOOST_CHECK(b.error() == code::bad);
+  a.swap(b);
+  BOOST_CHECK(a.has_error());
+  BOOST_CHECK(b.value() == 5);
+}
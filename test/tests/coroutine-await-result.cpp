@@ -0,0 +1,167 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/coroutine_support.hpp"
+#include "../../include/outcome.hpp"
+
+#ifdef OUTCOME_FOUND_COROUTINE_HEADER
+
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+
+namespace coroutine_await_result
+{
+  namespace awaitables = OUTCOME_V2_NAMESPACE::awaitables;
+  template <class T> using eager = awaitables::eager<T>;
+  template <class T> using lazy = awaitables::lazy<T>;
+  template <class T> using atomic_lazy = awaitables::atomic_lazy<T>;
+  template <class T, class E = std::error_code> using result = OUTCOME_V2_NAMESPACE::result<T, E>;
+  template <class T> using outcome = OUTCOME_V2_NAMESPACE::outcome<T>;
+
+  static int reached, alive;
+  struct local_counter
+  {
+    local_counter() noexcept { ++alive; }
+    local_counter(const local_counter &) = delete;
+    ~local_counter() { --alive; }
+  };
+
+  inline result<int> parse(const std::string &s)
+  {
+    if(s.empty() || s[0] < '0' || s[0] > '9')
+    {
+      return std::errc::invalid_argument;
+    }
+    return s[0] - '0';
+  }
+  inline result<void> check(int x)
+  {
+    if(x > 5)
+    {
+      return std::errc::result_out_of_range;
+    }
+    return OUTCOME_V2_NAMESPACE::success();
+  }
+  inline eager<result<int>> add(std::string a, std::string b)
+  {
+    local_counter c;
+    int x = co_await parse(a);
+    ++reached;
+    int y = co_await parse(b);
+    ++reached;
+    co_await check(x + y);
+    co_return x + y;
+  }
+}  // namespace coroutine_await_result
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / coroutine / await_result, "Tests that co_await on a result returns its value or ends the coroutine with its error")
+{
+  using namespace coroutine_await_result;
+  reached = 0;
+  {
+    auto t = add("1", "2");
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 3);
+    BOOST_CHECK(reached == 2);
+  }
+  BOOST_CHECK(alive == 0);
+  reached = 0;
+  {
+    auto t = add("1", "x");
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().error() == std::errc::invalid_argument);
+    BOOST_CHECK(reached == 1);
+    BOOST_CHECK(alive == 1);  // until the coroutine is destroyed
+  }
+  BOOST_CHECK(alive == 0);
+  {
+    auto t = add("3", "4");
+    BOOST_CHECK(t.await_resume().error() == std::errc::result_out_of_range);
+  }
+  {
+    // Lvalue results hand back a reference to their value
+    auto t = []() -> lazy<result<std::string>> {
+      result<std::string> r(std::string("hello"));
+      auto &v = co_await r;
+      v += " world";
+      co_return r;
+    }();
+    t._h.resume();
+    BOOST_CHECK(t.await_resume().value() == "hello world");
+  }
+  {
+    // Rvalue results hand back their value, moved
+    auto t = []() -> lazy<result<std::string>> {
+      std::string v = co_await result<std::string>(std::string("hello"));
+      co_return v;
+    }();
+    t._h.resume();
+    BOOST_CHECK(t.await_resume().value() == "hello");
+  }
+  {
+    // Errors of results end coroutines returning outcomes
+    auto t = []() -> lazy<outcome<int>> {
+      int x = co_await parse("x");
+      co_return x;
+    }();
+    t._h.resume();
+    BOOST_CHECK(t.await_resume().error() == std::errc::invalid_argument);
+  }
+  {
+    // The awaiter of a coroutine ended early by an error is resumed
+    auto t = []() -> lazy<result<int>> {
+      auto inner = []() -> lazy<result<int>> { co_return co_await parse("x"); };
+      int x = co_await co_await inner();
+      co_return x + 1;
+    }();
+    t._h.resume();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().error() == std::errc::invalid_argument);
+    auto s = awaitables::sync_wait([]() -> atomic_lazy<result<int>> { co_return co_await parse("y"); }());
+    BOOST_CHECK(s.error() == std::errc::invalid_argument);
+  }
+  {
+    // OUTCOME_CO_TRY_ALL ends the coroutine with the first failure of its inputs
+    auto t = []() -> lazy<result<int>> {
+      OUTCOME_CO_TRY_ALL((auto x, parse("1")), (auto y, parse("x")), (check(9)));
+      co_return x + y;
+    }();
+    t._h.resume();
+    BOOST_CHECK(t.await_resume().error() == std::errc::invalid_argument);
+    auto u = []() -> lazy<result<int>> {
+      OUTCOME_CO_TRY_ALL((auto x, parse("1")), (auto y, parse("2")), (check(3)));
+      co_return x + y;
+    }();
+    u._h.resume();
+    BOOST_CHECK(u.await_resume().value() == 3);
+  }
+}
+
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
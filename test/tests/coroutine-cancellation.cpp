@@ -0,0 +1,158 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/coroutine_support.hpp"
+#include "../../include/outcome.hpp"
+
+#if OUTCOME_FOUND_COROUTINE_HEADER && OUTCOME_HAVE_NOOP_COROUTINE
+
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <vector>
+
+namespace coroutine_cancellation
+{
+  namespace awaitables = OUTCOME_V2_NAMESPACE::awaitables;
+  template <class T> using lazy = awaitables::lazy<T>;
+  template <class T, class E = std::error_code> using result = OUTCOME_V2_NAMESPACE::result<T, E>;
+  using awaitables::cancellation_source;
+  using awaitables::cancellation_token;
+
+  // Resumes its waiters when fired
+  struct event
+  {
+    std::vector<awaitables::coroutine_handle<>> waiters;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(awaitables::coroutine_handle<> h) { waiters.push_back(h); }
+    void await_resume() noexcept {}
+    void fire()
+    {
+      auto w = std::move(waiters);
+      for(auto h : w)
+      {
+        h.resume();
+      }
+    }
+  };
+
+  static int steps;
+
+  // Does a step of work each time the event fires
+  inline lazy<result<int>> worker(event &e, int count)
+  {
+    for(int n = 0; n < count; n++)
+    {
+      co_await e;
+      ++steps;
+    }
+    co_return count;
+  }
+  inline lazy<result<int>> cancellable_worker(cancellation_token /*unused*/, event &e, int count) { co_return co_await worker(e, count); }
+  inline lazy<result<int>> failer(cancellation_source src, event &e)
+  {
+    co_await e;
+    src.request_cancellation();
+    co_return std::errc::io_error;
+  }
+}  // namespace coroutine_cancellation
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / coroutine / cancellation, "Tests that cancellation tokens end coroutines early with operation_canceled")
+{
+  using namespace coroutine_cancellation;
+  {
+    // A token which is never cancelled changes nothing
+    cancellation_source src;
+    event e;
+    steps = 0;
+    auto t = cancellable_worker(src.token(), e, 2);
+    t._h.resume();
+    e.fire();
+    e.fire();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 2);
+    BOOST_CHECK(steps == 2);
+    BOOST_CHECK(!src.is_cancellation_requested());
+  }
+  {
+    // A child inherits the token of its awaiter, and is cancelled at its next suspension point
+    cancellation_source src;
+    event e;
+    steps = 0;
+    auto t = cancellable_worker(src.token(), e, 5);
+    t._h.resume();
+    e.fire();
+    BOOST_CHECK(steps == 1);
+    BOOST_CHECK(src.request_cancellation());
+    BOOST_CHECK(!src.request_cancellation());
+    e.fire();  // step two completes, then the child is cancelled instead of suspending
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(steps == 2);
+    BOOST_CHECK(t.await_resume().error() == std::errc::operation_canceled);
+    BOOST_CHECK(e.waiters.empty());
+  }
+  {
+    // A lazy child cancelled before it started never runs
+    cancellation_source src;
+    src.request_cancellation();
+    event e;
+    steps = 0;
+    auto t = [](cancellation_token tok, event &e) -> lazy<result<int>> { co_return co_await cancellable_worker(tok, e, 1); }(src.token(), e);
+    t._h.resume();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().error() == std::errc::operation_canceled);
+    BOOST_CHECK(e.waiters.empty());
+  }
+  {
+    // A failing sibling cancels the others, which stop early rather than running to completion
+    cancellation_source src;
+    event e;
+    steps = 0;
+    auto t = [](cancellation_source src, event &e) -> lazy<result<int>> {
+      auto r = co_await awaitables::when_all(cancellable_worker(src.token(), e, 100), failer(src, e), cancellable_worker(src.token(), e, 100));
+      co_return r.error();
+    }(src, e);
+    t._h.resume();
+    e.fire();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().error() == std::errc::io_error);
+    BOOST_CHECK(steps == 2);
+    e.fire();  // the first worker was suspended before cancellation, so does one more step
+    BOOST_CHECK(steps == 3);
+    BOOST_CHECK(e.waiters.empty());
+  }
+  {
+    // A default constructed token can never be cancelled
+    cancellation_token tok;
+    BOOST_CHECK(!tok.can_be_cancelled());
+    BOOST_CHECK(!tok.is_cancellation_requested());
+  }
+}
+
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,215 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/coroutine_support.hpp"
+#include "../../include/outcome/channel.hpp"
+#include "../../include/outcome.hpp"
+
+#if OUTCOME_FOUND_COROUTINE_HEADER && OUTCOME_HAVE_NOOP_COROUTINE
+
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace coroutine_channel
+{
+  namespace awaitables = OUTCOME_V2_NAMESPACE::awaitables;
+  template <class T> using eager = awaitables::eager<T>;
+  template <class T> using atomic_eager = awaitables::atomic_eager<T>;
+  template <class T, class E = std::error_code> using result = OUTCOME_V2_NAMESPACE::result<T, E>;
+  using channel = awaitables::channel<result<int>>;
+
+  inline eager<result<void>> produce(channel &ch, int from, int to, int &sent)
+  {
+    for(int n = from; n < to; n++)
+    {
+      OUTCOME_CO_TRY(co_await ch.send(n));
+      ++sent;
+    }
+    co_return OUTCOME_V2_NAMESPACE::success();
+  }
+  inline eager<result<void>> consume(channel &ch, std::vector<int> &received, std::error_code &closed_with)
+  {
+    for(;;)
+    {
+      auto r = co_await ch.receive();
+      if(!r)
+      {
+        closed_with = r.error();
+        co_return OUTCOME_V2_NAMESPACE::success();
+      }
+      received.push_back(r.value());
+    }
+  }
+  inline atomic_eager<result<long>> threaded_produce(channel &ch, int from, int to)
+  {
+    long ret = 0;
+    for(int n = from; n < to; n++)
+    {
+      OUTCOME_CO_TRY(co_await ch.send(n));
+      ret += n;
+    }
+    co_return ret;
+  }
+  inline atomic_eager<result<long>> threaded_consume(channel &ch)
+  {
+    long ret = 0;
+    for(;;)
+    {
+      auto r = co_await ch.receive();
+      if(!r)
+      {
+        co_return ret;
+      }
+      ret += r.value();
+    }
+  }
+}  // namespace coroutine_channel
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / coroutine / channel, "Tests that the bounded channel of results passes items, suspends when full, and closes with a terminal error")
+{
+  using namespace coroutine_channel;
+  {
+    // Capacity is rounded up to a power of two of at least two
+    channel ch(3);
+    BOOST_CHECK(ch.capacity() == 4);
+    BOOST_CHECK(channel(1).capacity() == 2);
+    BOOST_CHECK(!ch.is_closed());
+  }
+  {
+    // A producer suspends when the channel is full, and is resumed by the consumer
+    channel ch(4);
+    int sent = 0;
+    auto p = produce(ch, 0, 10, sent);
+    BOOST_CHECK(sent == 4);
+    BOOST_CHECK(!p.await_ready());
+    std::vector<int> received;
+    std::error_code closed_with;
+    auto c = consume(ch, received, closed_with);
+    BOOST_CHECK(sent == 10);
+    BOOST_REQUIRE(p.await_ready());
+    BOOST_CHECK(p.await_resume().has_value());
+    BOOST_CHECK(received.size() == 10);
+    for(int n = 0; n < 10; n++)
+    {
+      BOOST_CHECK(received[n] == n);
+    }
+    // The consumer suspends when the channel is empty, and observes the terminal error
+    BOOST_CHECK(!c.await_ready());
+    ch.close(make_error_code(std::errc::broken_pipe));
+    BOOST_REQUIRE(c.await_ready());
+    BOOST_CHECK(closed_with == std::errc::broken_pipe);
+    BOOST_CHECK(ch.is_closed());
+  }
+  {
+    // Items sent before close are received before the terminal error, and sends after close fail
+    channel ch(8);
+    int sent = 0;
+    auto p = produce(ch, 0, 3, sent);
+    BOOST_CHECK(p.await_ready());
+    ch.close(make_error_code(std::errc::operation_canceled));
+    ch.close(make_error_code(std::errc::broken_pipe));  // only the first close counts
+    auto late = produce(ch, 3, 4, sent);
+    BOOST_REQUIRE(late.await_ready());
+    BOOST_CHECK(late.await_resume().error() == std::errc::operation_canceled);
+    BOOST_CHECK(sent == 3);
+    std::vector<int> received;
+    std::error_code closed_with;
+    auto c = consume(ch, received, closed_with);
+    BOOST_CHECK(c.await_ready());
+    BOOST_CHECK(received.size() == 3);
+    BOOST_CHECK(closed_with == std::errc::operation_canceled);
+  }
+  {
+    // Every waiting producer and consumer observes the terminal error
+    channel full(2), empty(2);
+    int sent = 0;
+    auto p1 = produce(full, 0, 3, sent);
+    auto p2 = produce(full, 0, 1, sent);
+    std::vector<int> r1, r2;
+    std::error_code e1, e2;
+    auto c1 = consume(empty, r1, e1);
+    auto c2 = consume(empty, r2, e2);
+    BOOST_CHECK(!p1.await_ready());
+    BOOST_CHECK(!p2.await_ready());
+    BOOST_CHECK(!c1.await_ready());
+    BOOST_CHECK(!c2.await_ready());
+    full.close(make_error_code(std::errc::broken_pipe));
+    empty.close(make_error_code(std::errc::broken_pipe));
+    BOOST_REQUIRE(p1.await_ready() && p2.await_ready() && c1.await_ready() && c2.await_ready());
+    BOOST_CHECK(p1.await_resume().error() == std::errc::broken_pipe);
+    BOOST_CHECK(p2.await_resume().error() == std::errc::broken_pipe);
+    BOOST_CHECK(e1 == std::errc::broken_pipe);
+    BOOST_CHECK(e2 == std::errc::broken_pipe);
+    BOOST_CHECK(sent == 2);
+  }
+  {
+    // Failures sent through the channel are items like any other
+    channel ch(2);
+    auto s = [](channel &ch) -> eager<result<void>> {
+      OUTCOME_CO_TRY(co_await ch.send(result<int>(std::errc::invalid_argument)));
+      co_return OUTCOME_V2_NAMESPACE::success();
+    }(ch);
+    BOOST_CHECK(s.await_ready());
+    auto r = [](channel &ch) -> eager<result<int>> { co_return co_await ch.receive(); }(ch);
+    BOOST_REQUIRE(r.await_ready());
+    BOOST_CHECK(r.await_resume().error() == std::errc::invalid_argument);
+  }
+  {
+    // Many producers and consumers on many threads
+    for(int round = 0; round < 10; round++)
+    {
+      channel ch(16);
+      std::vector<std::thread> threads;
+      std::atomic<long> produced{0}, consumed{0};
+      for(int n = 0; n < 3; n++)
+      {
+        threads.emplace_back([&] { consumed += awaitables::sync_wait(threaded_consume(ch)).value(); });
+      }
+      for(int n = 0; n < 3; n++)
+      {
+        threads.emplace_back([&, n] { produced += awaitables::sync_wait(threaded_produce(ch, n * 10000, (n + 1) * 10000)).value(); });
+      }
+      for(size_t n = 3; n < 6; n++)
+      {
+        threads[n].join();
+      }
+      ch.close(make_error_code(std::errc::broken_pipe));
+      for(size_t n = 0; n < 3; n++)
+      {
+        threads[n].join();
+      }
+      BOOST_CHECK(produced == 449985000L);
+      BOOST_CHECK(consumed == produced);
+    }
+  }
+}
+
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
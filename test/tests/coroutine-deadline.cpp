@@ -0,0 +1,250 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/coroutine_support.hpp"
+#include "../../include/outcome/reactor.hpp"
+#include "../../include/outcome.hpp"
+
+#if OUTCOME_FOUND_COROUTINE_HEADER && OUTCOME_HAVE_NOOP_COROUTINE && defined(__linux__)
+
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace coroutine_deadline
+{
+  namespace awaitables = OUTCOME_V2_NAMESPACE::awaitables;
+  template <class T> using eager = awaitables::eager<T>;
+  template <class T> using lazy = awaitables::lazy<T>;
+  template <class T, class E = std::error_code> using result = OUTCOME_V2_NAMESPACE::result<T, E>;
+  using clock = std::chrono::steady_clock;
+  using std::chrono::milliseconds;
+
+  inline eager<result<void>> sleeper(awaitables::reactor &r, milliseconds d, std::vector<int> &order, int id)
+  {
+    OUTCOME_CO_TRY(co_await awaitables::sleep_for(r, d));
+    order.push_back(id);
+    co_return OUTCOME_V2_NAMESPACE::success();
+  }
+  struct on_exit
+  {
+    int &count;
+    ~on_exit() { ++count; }
+  };
+  inline lazy<result<int>> read_then_sleep(awaitables::reactor &r, awaitables::io_handle &h, int &exited)
+  {
+    on_exit e{exited};
+    std::vector<char> buffer(64);  // leaked, were the frame never destroyed
+    OUTCOME_CO_TRY(auto bytes, co_await awaitables::async_read(h, buffer.data(), buffer.size()));
+    OUTCOME_CO_TRY(co_await awaitables::sleep_for(r, std::chrono::hours(1)));
+    co_return static_cast<int>(bytes);
+  }
+  inline eager<result<size_t>> read_one(awaitables::cancellation_token /*unused*/, awaitables::io_handle &h, char &c) { co_return co_await awaitables::async_read(h, &c, 1); }
+  inline lazy<result<int>> sleep_then_return(awaitables::reactor &r, milliseconds d, int v)
+  {
+    OUTCOME_CO_TRY(co_await awaitables::sleep_for(r, d));
+    co_return v;
+  }
+  inline lazy<result<int>> immediately(int v) { co_return v; }
+  template <class T> inline eager<result<T>> deadline(awaitables::reactor &r, lazy<result<T>> task, milliseconds d) { co_return co_await awaitables::with_deadline(r, std::move(task), d); }
+  template <class Awaitable> inline void run_until_ready(awaitables::reactor &r, Awaitable &a)
+  {
+    while(!a.await_ready())
+    {
+      BOOST_REQUIRE(r.run_once(5000).has_value());
+    }
+  }
+}  // namespace coroutine_deadline
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / coroutine / deadline, "Tests that reactor timers sleep, and deadlines fail tasks with timed_out")
+{
+  using namespace coroutine_deadline;
+  {
+    // The timer wheel expires every timer exactly on its tick, however far out, however the ticks are advanced
+    int fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    BOOST_REQUIRE(fd != -1);
+    awaitables::detail::timer_wheel wheel(fd);
+    std::mt19937_64 rand(78);
+    struct entry : awaitables::detail::timer_entry
+    {
+      uint64_t due;
+    };
+    std::vector<entry> entries(3000);
+    for(size_t n = 0; n < entries.size(); n++)
+    {
+      // Spread over every level, and beyond the span of the wheel
+      const unsigned level = static_cast<unsigned>(n % 5);
+      entries[n].due = 1 + rand() % (uint64_t(1) << (6 * level + 6));
+      entries[n].expiry = entries[n].due;
+      wheel.add(&entries[n]);
+    }
+    BOOST_REQUIRE(std::max_element(entries.begin(), entries.end(), [](const entry &a, const entry &b) { return a.due < b.due; })->due > (uint64_t(1) << 24));
+    size_t expired = 0;
+    for(uint64_t now = 0; expired < entries.size();)
+    {
+      now += 1 + rand() % ((rand() % 2) ? 100 : (1 << 22));
+      wheel.advance(now);
+      size_t count = 0;
+      while(auto *e = static_cast<entry *>(wheel.pop_expired()))
+      {
+        BOOST_CHECK(e->due <= now);
+        e->due = 0;
+        ++count;
+      }
+      expired += count;
+      // Everything due by now has been expired
+      for(auto &e : entries)
+      {
+        if(e.due != 0 && e.due <= now)
+        {
+          BOOST_CHECK(e.due > now);
+        }
+      }
+    }
+    BOOST_CHECK(wheel.next_tick() == awaitables::detail::timer_wheel::none);
+  }
+  auto r = awaitables::reactor::make().value();
+  {
+    // Sleepers wake in order of deadline, no earlier than their deadline
+    std::vector<int> order;
+    const auto begin = clock::now();
+    auto a = sleeper(r, milliseconds(30), order, 3);
+    auto b = sleeper(r, milliseconds(10), order, 1);
+    auto c = sleeper(r, milliseconds(20), order, 2);
+    auto d = sleeper(r, milliseconds(0), order, 0);
+    BOOST_CHECK(d.await_ready());
+    {
+      // A coroutine destroyed while sleeping cancels its timer
+      auto e = sleeper(r, std::chrono::hours(1), order, 4);
+    }
+    run_until_ready(r, a);
+    BOOST_CHECK(clock::now() - begin >= milliseconds(30));
+    BOOST_CHECK(b.await_ready() && c.await_ready());
+    BOOST_CHECK((order == std::vector<int>{0, 1, 2, 3}));
+  }
+  {
+    // A task which completes in time returns its result, and its timer is cancelled
+    auto t = deadline(r, sleep_then_return(r, milliseconds(10), 5), milliseconds(1000));
+    const auto begin = clock::now();
+    run_until_ready(r, t);
+    BOOST_CHECK(t.await_resume().value() == 5);
+    BOOST_CHECK(clock::now() - begin < milliseconds(1000));
+    BOOST_CHECK(r.run_once(0).value() == 0);
+  }
+  {
+    // A task which completes without suspending never starts a timer
+    auto t = deadline(r, immediately(6), milliseconds(1000));
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 6);
+    // A zero deadline has expired before the task can start
+    auto u = deadline(r, immediately(7), milliseconds(0));
+    BOOST_REQUIRE(u.await_ready());
+    BOOST_CHECK(u.await_resume().error() == std::errc::timed_out);
+  }
+  {
+    // A task which does not complete in time fails with timed_out, and its pending read is abandoned
+    int fds[2];
+    BOOST_REQUIRE(::pipe(fds) == 0);
+    int exited = 0;
+    {
+      auto rd = r.attach(fds[0]).value();
+      auto wr = r.attach(fds[1]).value();
+      const auto begin = clock::now();
+      auto t = deadline(r, read_then_sleep(r, rd, exited), milliseconds(20));
+      BOOST_CHECK(!t.await_ready());
+      run_until_ready(r, t);
+      BOOST_CHECK(clock::now() - begin >= milliseconds(20));
+      BOOST_CHECK(t.await_resume().error() == std::errc::timed_out);
+      // The task was resumed with operation_canceled and destroyed before the deadline returned
+      BOOST_CHECK(exited == 1);
+      // Nothing is left parked on the pipe, so closing it without ever writing is fine
+    }
+    BOOST_CHECK(r.run_once(0).value() == 0);
+  }
+  {
+    // A read whose token is already cancelled never suspends
+    int fds[2];
+    BOOST_REQUIRE(::pipe(fds) == 0);
+    auto rd = r.attach(fds[0]).value();
+    auto wr = r.attach(fds[1]).value();
+    awaitables::cancellation_source source;
+    source.request_cancellation();
+    char c;
+    auto a = awaitables::async_read(rd, &c, 1);
+    inherit_cancellation_token(a, source.token());
+    BOOST_REQUIRE(!a.await_ready());
+    BOOST_CHECK(!a.await_suspend({}));
+    BOOST_CHECK(a.await_resume().error() == std::errc::operation_canceled);
+  }
+  {
+    // Cancellation requested on another thread is handed to the reactor, so a read racing
+    // with it either completes or is abandoned, never both
+    int fds[2];
+    BOOST_REQUIRE(::pipe(fds) == 0);
+    auto rd = r.attach(fds[0]).value();
+    size_t cancelled = 0;
+    for(int n = 0; n < 1000; n++)
+    {
+      awaitables::cancellation_source source;
+      char c = 0;
+      auto t = read_one(source.token(), rd, c);
+      BOOST_REQUIRE(!t.await_ready());
+      std::thread canceller([&] { source.request_cancellation(); });
+      const bool written = (n % 2 == 0);
+      if(written)
+      {
+        BOOST_REQUIRE(::write(fds[1], "x", 1) == 1);
+      }
+      run_until_ready(r, t);
+      canceller.join();
+      auto res = t.await_resume();
+      char d;
+      if(res)
+      {
+        BOOST_CHECK(written && res.value() == 1U && c == 'x');
+        BOOST_CHECK(::read(fds[0], &d, 1) == -1);
+      }
+      else
+      {
+        ++cancelled;
+        BOOST_CHECK(res.error() == std::errc::operation_canceled);
+        // The byte was left in the pipe
+        BOOST_CHECK(::read(fds[0], &d, 1) == (written ? 1 : -1));
+      }
+      BOOST_CHECK(r.run_once(0).value() == 0);
+    }
+    BOOST_CHECK(cancelled >= 500U);
+    ::close(fds[1]);
+  }
+}
+
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
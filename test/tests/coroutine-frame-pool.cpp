@@ -0,0 +1,137 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/coroutine_support.hpp"
+#include "../../include/outcome.hpp"
+
+#if OUTCOME_FOUND_COROUTINE_HEADER
+
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <memory>
+#include <thread>
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 13
+// GCC 12 mistakes the frame deallocation of coroutines taking std::allocator_arg as mismatched
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace coroutine_frame_pool
+{
+  template <class T> using lazy = OUTCOME_V2_NAMESPACE::awaitables::lazy<T>;
+  template <class T> using atomic_lazy = OUTCOME_V2_NAMESPACE::awaitables::atomic_lazy<T>;
+  template <class T> using eager = OUTCOME_V2_NAMESPACE::awaitables::eager<T>;
+  template <class T, class E = std::error_code> using result = OUTCOME_V2_NAMESPACE::result<T, E>;
+
+  static size_t allocated, deallocated;
+  template <class T> struct counting_allocator
+  {
+    using value_type = T;
+    counting_allocator() = default;
+    template <class U>
+    counting_allocator(const counting_allocator<U> & /*unused*/) noexcept  // NOLINT
+    {
+    }
+    T *allocate(size_t n)
+    {
+      ++allocated;
+      return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T *p, size_t n) noexcept
+    {
+      ++deallocated;
+      std::allocator<T>().deallocate(p, n);
+    }
+    template <class U> bool operator==(const counting_allocator<U> & /*unused*/) const noexcept { return true; }
+    template <class U> bool operator!=(const counting_allocator<U> & /*unused*/) const noexcept { return false; }
+  };
+
+  inline lazy<result<int>> lazy_int(int x) { co_return x + 1; }
+  inline atomic_lazy<result<int>> atomic_lazy_int(int x) { co_return x + 1; }
+  inline lazy<result<int>> lazy_alloc(std::allocator_arg_t /*unused*/, counting_allocator<char> /*unused*/, int x) { co_return x + 1; }
+  inline eager<result<void>> eager_alloc(std::allocator_arg_t /*unused*/, counting_allocator<char> /*unused*/) { co_return OUTCOME_V2_NAMESPACE::success(); }
+  struct object
+  {
+    int v{5};
+    lazy<result<int>> get(std::allocator_arg_t /*unused*/, counting_allocator<int> /*unused*/) { co_return v; }
+  };
+
+  template <class T> inline auto run(T &&t)
+  {
+    while(!t.await_ready())
+    {
+      t._h.resume();
+    }
+    return t.await_resume();
+  }
+}  // namespace coroutine_frame_pool
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / coroutine / frame_pool, "Tests that coroutine frames are pooled, or allocated with a supplied allocator")
+{
+  using namespace coroutine_frame_pool;
+#if OUTCOME_COROUTINE_FRAME_POOL
+  {
+    // A freed frame is reused by the next coroutine of the same size class
+    void *addr;
+    {
+      auto t = lazy_int(5);
+      addr = t._h.address();
+      BOOST_CHECK(run(t).value() == 6);
+    }
+    auto t = lazy_int(6);
+    BOOST_CHECK(t._h.address() == addr);
+    BOOST_CHECK(run(t).value() == 7);
+  }
+#endif
+  {
+    // Frames may be freed on a different thread to the one which allocated them
+    auto t = atomic_lazy_int(5);
+    std::thread([t = std::move(t)]() mutable { BOOST_CHECK(run(t).value() == 6); }).join();
+    BOOST_CHECK(run(atomic_lazy_int(6)).value() == 7);
+  }
+  {
+    // Frames of free functions may use the allocator passed after std::allocator_arg
+    {
+      auto t = lazy_alloc(std::allocator_arg, counting_allocator<char>(), 5);
+      BOOST_CHECK(allocated == 1);
+      BOOST_CHECK(deallocated == 0);
+      BOOST_CHECK(run(t).value() == 6);
+    }
+    BOOST_CHECK(deallocated == 1);
+    BOOST_CHECK(run(eager_alloc(std::allocator_arg, counting_allocator<char>())).has_value());
+    BOOST_CHECK(allocated == 2);
+    BOOST_CHECK(deallocated == 2);
+    // As may member functions
+    object o;
+    BOOST_CHECK(run(o.get(std::allocator_arg, counting_allocator<int>())).value() == 5);
+    BOOST_CHECK(allocated == 3);
+    BOOST_CHECK(deallocated == 3);
+  }
+}
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,156 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/coroutine_support.hpp"
+#include "../../include/outcome.hpp"
+
+#if OUTCOME_FOUND_COROUTINE_HEADER
+
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+#include <vector>
+
+namespace coroutine_generator
+{
+  template <class T> using generator = OUTCOME_V2_NAMESPACE::awaitables::generator<T>;
+  template <class T, class E = std::error_code> using result = OUTCOME_V2_NAMESPACE::result<T, E>;
+
+  // Counts copies and moves
+  static int copies, moves;
+  struct record
+  {
+    int v;
+    explicit record(int _v) noexcept
+        : v(_v)
+    {
+    }
+    record(const record &o) noexcept
+        : v(o.v)
+    {
+      ++copies;
+    }
+    record(record &&o) noexcept
+        : v(o.v)
+    {
+      ++moves;
+    }
+    record &operator=(const record &) = delete;
+    record &operator=(record &&) = delete;
+    ~record() = default;
+  };
+
+  inline generator<result<int>> parse(std::vector<std::string> lines)
+  {
+    for(auto &line : lines)
+    {
+      if(line.empty() || line[0] < '0' || line[0] > '9')
+      {
+        co_yield std::errc::invalid_argument;
+      }
+      else
+      {
+        co_yield std::stoi(line);
+      }
+    }
+  }
+  inline generator<result<record>> records(int count)
+  {
+    for(int n = 0; n < count; n++)
+    {
+      co_yield result<record>(OUTCOME_V2_NAMESPACE::in_place_type<record>, n);
+    }
+  }
+#ifdef __cpp_exceptions
+  inline generator<result<int>> throws()
+  {
+    co_yield 1;
+    throw std::invalid_argument("hi");
+  }
+#endif
+}  // namespace coroutine_generator
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / coroutine / generator, "Tests that generator yields a sequence of results")
+{
+  using namespace coroutine_generator;
+  {
+    std::vector<result<int>> out;
+    for(auto &r : parse({"1", "2", "x", "4"}))
+    {
+      out.push_back(std::move(r));
+    }
+    BOOST_REQUIRE(out.size() == 4);
+    BOOST_CHECK(out[0].value() == 1);
+    BOOST_CHECK(out[1].value() == 2);
+    BOOST_CHECK(out[2].error() == std::errc::invalid_argument);
+    BOOST_CHECK(out[3].value() == 4);
+  }
+  {
+    // Stops after the first failure
+    std::vector<result<int>> out;
+    for(auto &r : parse({"1", "x", "3"}).stop_on_failure())
+    {
+      out.push_back(std::move(r));
+    }
+    BOOST_REQUIRE(out.size() == 2);
+    BOOST_CHECK(out[1].error() == std::errc::invalid_argument);
+  }
+  {
+    // Yielded rvalues are neither copied nor moved
+    int sum = 0;
+    for(auto &r : records(10))
+    {
+      sum += r.value().v;
+    }
+    BOOST_CHECK(sum == 45);
+    BOOST_CHECK(copies == 0);
+    BOOST_CHECK(moves == 0);
+  }
+  {
+    // Empty sequences, and abandoned sequences
+    auto g = parse({});
+    BOOST_CHECK(g.begin() == g.end());
+    auto h = parse({"1", "2"});
+    auto it = h.begin();
+    BOOST_CHECK(it->value() == 1);
+  }
+#ifdef __cpp_exceptions
+  {
+    // Exceptions thrown become a final failed element
+    std::vector<result<int>> out;
+    for(auto &r : throws())
+    {
+      out.push_back(std::move(r));
+    }
+    BOOST_REQUIRE(out.size() == 2);
+    BOOST_CHECK(out[1].error() == std::errc::invalid_argument);
+  }
+#endif
+}
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
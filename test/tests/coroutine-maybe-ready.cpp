@@ -0,0 +1,123 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/coroutine_support.hpp"
+#include "../../include/outcome.hpp"
+
+#ifdef OUTCOME_FOUND_COROUTINE_HEADER
+
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <map>
+#include <vector>
+
+namespace coroutine_maybe_ready
+{
+  namespace awaitables = OUTCOME_V2_NAMESPACE::awaitables;
+  template <class T> using eager = awaitables::eager<T>;
+  template <class T> using lazy = awaitables::lazy<T>;
+  template <class T> using maybe_ready = awaitables::maybe_ready<T>;
+  template <class T, class E = std::error_code> using result = OUTCOME_V2_NAMESPACE::result<T, E>;
+
+  static int frames;
+
+  inline eager<result<int>> slow_lookup(std::map<int, int> &cache, int key)
+  {
+    ++frames;
+    if(key < 0)
+    {
+      co_return std::errc::invalid_argument;
+    }
+    cache[key] = key * 10;
+    co_return key * 10;
+  }
+  // Not a coroutine, so a cache hit creates no coroutine frame
+  inline maybe_ready<eager<result<int>>> lookup(std::map<int, int> &cache, int key)
+  {
+    auto it = cache.find(key);
+    if(it != cache.end())
+    {
+      return it->second;
+    }
+    return slow_lookup(cache, key);
+  }
+  inline lazy<result<int>> sum(std::map<int, int> &cache, std::vector<int> keys)
+  {
+    int ret = 0;
+    for(int key : keys)
+    {
+      OUTCOME_CO_TRY(auto v, co_await lookup(cache, key));
+      ret += v;
+    }
+    co_return ret;
+  }
+}  // namespace coroutine_maybe_ready
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / coroutine / maybe_ready, "Tests that maybe_ready holds ready values without a coroutine frame")
+{
+  using namespace coroutine_maybe_ready;
+  static_assert(sizeof(maybe_ready<eager<result<int>>>) <= sizeof(result<int>) + sizeof(void *), "maybe_ready should be no bigger than its value and a handle");
+  std::map<int, int> cache;
+  frames = 0;
+  {
+    auto a = lookup(cache, 1);
+    BOOST_CHECK(!a.is_ready_value());
+    BOOST_CHECK(a.await_ready());
+    BOOST_CHECK(a.await_resume().value() == 10);
+    BOOST_CHECK(frames == 1);
+    auto b = lookup(cache, 1);
+    BOOST_CHECK(b.is_ready_value());
+    BOOST_CHECK(b.await_ready());
+    BOOST_CHECK(b.await_resume().value() == 10);
+    BOOST_CHECK(frames == 1);
+  }
+  {
+    auto t = sum(cache, {1, 2, 1, 2, 1});
+    t._h.resume();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 70);
+    BOOST_CHECK(frames == 2);
+  }
+  {
+    auto t = sum(cache, {1, -1, 2});
+    t._h.resume();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().error() == std::errc::invalid_argument);
+    BOOST_CHECK(frames == 3);
+  }
+  {
+    // Values convertible to the result are ready values too
+    maybe_ready<lazy<result<int>>> v(5);
+    BOOST_CHECK(v.is_ready_value());
+    maybe_ready<lazy<result<int>>> w(std::move(v));
+    BOOST_CHECK(w.await_resume().value() == 5);
+  }
+}
+
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,178 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/coroutine_support.hpp"
+#include "../../include/outcome/reactor.hpp"
+#include "../../include/outcome.hpp"
+
+#if OUTCOME_FOUND_COROUTINE_HEADER && defined(__linux__)
+
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <csignal>
+#include <string>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+namespace coroutine_reactor
+{
+  namespace awaitables = OUTCOME_V2_NAMESPACE::awaitables;
+  template <class T> using eager = awaitables::eager<T>;
+  template <class T> using lazy = awaitables::lazy<T>;
+  template <class T, class E = std::error_code> using result = OUTCOME_V2_NAMESPACE::result<T, E>;
+
+  inline eager<result<std::string>> read_all(awaitables::io_handle &h)
+  {
+    std::string ret;
+    char buffer[7];
+    for(;;)
+    {
+      OUTCOME_CO_TRY(auto bytes, co_await awaitables::async_read(h, buffer, sizeof(buffer)));
+      if(bytes == 0)
+      {
+        co_return ret;
+      }
+      ret.append(buffer, bytes);
+    }
+  }
+  inline eager<result<size_t>> write_all(awaitables::io_handle &h, const std::string &s)
+  {
+    size_t written = 0;
+    while(written < s.size())
+    {
+      OUTCOME_CO_TRY(auto bytes, co_await awaitables::async_write(h, s.data() + written, s.size() - written));
+      written += bytes;
+    }
+    co_return written;
+  }
+  inline lazy<result<std::string>> echo_once(awaitables::reactor &r, awaitables::io_handle &listener)
+  {
+    OUTCOME_CO_TRY(auto fd, co_await awaitables::async_accept(listener));
+    OUTCOME_CO_TRY(auto conn, r.attach(fd));
+    char buffer[64];
+    OUTCOME_CO_TRY(auto bytes, co_await awaitables::async_read(conn, buffer, sizeof(buffer)));
+    OUTCOME_CO_TRY(co_await awaitables::async_write(conn, buffer, bytes));
+    co_return std::string(buffer, bytes);
+  }
+  template <class Awaitable> inline void run_until_ready(awaitables::reactor &r, Awaitable &a)
+  {
+    while(!a.await_ready())
+    {
+      BOOST_REQUIRE(r.run_once(1000).has_value());
+    }
+  }
+}  // namespace coroutine_reactor
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / coroutine / reactor, "Tests that the epoll reactor completes reads, writes and accepts as results")
+{
+  using namespace coroutine_reactor;
+  auto r = awaitables::reactor::make().value();
+  {
+    // A reader suspends until the writer fills the pipe, and a writer suspends while the pipe is full
+    int fds[2];
+    BOOST_REQUIRE(::pipe(fds) == 0);
+    auto rd = r.attach(fds[0]).value();
+    auto wr = r.attach(fds[1]).value();
+    auto reader = read_all(rd);
+    BOOST_CHECK(!reader.await_ready());
+    std::string big(1024 * 1024, 'x');
+    for(size_t n = 0; n < big.size(); n++)
+    {
+      big[n] = static_cast<char>('a' + n % 26);
+    }
+    auto writer = write_all(wr, big);
+    BOOST_CHECK(!writer.await_ready());  // a pipe holds less than a megabyte
+    run_until_ready(r, writer);
+    BOOST_CHECK(writer.await_resume().value() == big.size());
+    wr = awaitables::io_handle();  // closing the write end gives the reader end of file
+    run_until_ready(r, reader);
+    BOOST_CHECK(reader.await_resume().value() == big);
+  }
+  {
+    // Writing to a pipe with no reader fails with EPIPE, once SIGPIPE is ignored
+    int fds[2];
+    BOOST_REQUIRE(::pipe(fds) == 0);
+    ::close(fds[0]);
+    ::signal(SIGPIPE, SIG_IGN);
+    auto wr = r.attach(fds[1]).value();
+    auto writer = write_all(wr, "hello");
+    BOOST_REQUIRE(writer.await_ready());
+    BOOST_CHECK(writer.await_resume().error() == std::errc::broken_pipe);
+  }
+  {
+    // Attaching a closed file descriptor fails
+    BOOST_CHECK(r.attach(-1).error() == std::errc::bad_file_descriptor);
+  }
+  {
+    // Accept a loopback TCP connection, and echo back what it sends
+    int lfd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    BOOST_REQUIRE(lfd != -1);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    BOOST_REQUIRE(::bind(lfd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+    BOOST_REQUIRE(::listen(lfd, 1) == 0);
+    socklen_t len = sizeof(addr);
+    BOOST_REQUIRE(::getsockname(lfd, reinterpret_cast<sockaddr *>(&addr), &len) == 0);
+    auto listener = r.attach(lfd).value();
+    // An eager awaiting the lazy, which suspends in accept
+    auto server = [](awaitables::reactor &r, awaitables::io_handle &listener) -> eager<result<std::string>> { co_return co_await echo_once(r, listener); }(r, listener);
+    BOOST_CHECK(!server.await_ready());
+
+    int cfd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    BOOST_REQUIRE(::connect(cfd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+    auto client = r.attach(cfd).value();
+    auto sent = write_all(client, "ping");
+    BOOST_CHECK(sent.await_ready());
+    auto reply = read_all(client);
+    run_until_ready(r, server);
+    BOOST_CHECK(server.await_resume().value() == "ping");
+    // The server's connection was closed when echo_once() returned
+    run_until_ready(r, reply);
+    BOOST_CHECK(reply.await_resume().value() == "ping");
+  }
+  {
+    // UNIX socket pairs work too
+    int sv[2];
+    BOOST_REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv) == 0);
+    auto a = r.attach(sv[0]).value();
+    auto b = r.attach(sv[1]).value();
+    auto reader = read_all(b);
+    auto writer = write_all(a, "over a socketpair");
+    BOOST_REQUIRE(writer.await_ready());
+    a = awaitables::io_handle();
+    run_until_ready(r, reader);
+    BOOST_CHECK(reader.await_resume().value() == "over a socketpair");
+  }
+}
+
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,194 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/coroutine_support.hpp"
+#include "../../include/outcome.hpp"
+
+#if OUTCOME_FOUND_COROUTINE_HEADER && OUTCOME_HAVE_NOOP_COROUTINE
+
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace coroutine_shared_lazy
+{
+  namespace awaitables = OUTCOME_V2_NAMESPACE::awaitables;
+  template <class T> using lazy = awaitables::lazy<T>;
+  template <class T> using atomic_lazy = awaitables::atomic_lazy<T>;
+  template <class T> using shared_lazy = awaitables::shared_lazy<T>;
+  template <class T, class E = std::error_code> using result = OUTCOME_V2_NAMESPACE::result<T, E>;
+
+  // Resumes its waiters when fired
+  struct event
+  {
+    std::vector<awaitables::coroutine_handle<>> waiters;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(awaitables::coroutine_handle<> h) { waiters.push_back(h); }
+    void await_resume() noexcept {}
+    void fire()
+    {
+      auto w = std::move(waiters);
+      for(auto h : w)
+      {
+        h.resume();
+      }
+    }
+  };
+
+  static std::atomic<int> runs, alive;
+  struct frame_counter
+  {
+    frame_counter() noexcept { ++alive; }
+    frame_counter(const frame_counter &) = delete;
+    ~frame_counter() { --alive; }
+  };
+
+  inline shared_lazy<result<std::string>> fetch(event &e, std::string key)
+  {
+    frame_counter c;
+    ++runs;
+    co_await e;
+    if(key.empty())
+    {
+      co_return std::errc::invalid_argument;
+    }
+    co_return "value of " + key;
+  }
+  inline lazy<result<size_t>> consumer(shared_lazy<result<std::string>> s)
+  {
+    const auto &r = co_await s;  // refers into the shared_lazy
+    OUTCOME_CO_TRY(auto &&v, r);
+    co_return v.size();
+  }
+}  // namespace coroutine_shared_lazy
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / coroutine / shared_lazy, "Tests that shared_lazy runs once no matter how many coroutines await it")
+{
+  using namespace coroutine_shared_lazy;
+  {
+    // Many consumers of the same computation, which only runs once
+    event e;
+    runs = 0;
+    auto s = fetch(e, "foo");
+    BOOST_CHECK(runs == 0);
+    BOOST_CHECK(!s.is_ready());
+    std::vector<lazy<result<size_t>>> consumers;
+    for(int n = 0; n < 3; n++)
+    {
+      consumers.push_back(consumer(s));
+      consumers.back()._h.resume();
+    }
+    BOOST_CHECK(runs == 1);
+    BOOST_CHECK(alive == 1);
+    e.fire();
+    BOOST_CHECK(s.is_ready());
+    BOOST_CHECK(alive == 0);
+    for(auto &c : consumers)
+    {
+      BOOST_REQUIRE(c.await_ready());
+      BOOST_CHECK(c.await_resume().value() == 12);
+    }
+    // A late consumer does not suspend
+    auto late = consumer(s);
+    late._h.resume();
+    BOOST_REQUIRE(late.await_ready());
+    BOOST_CHECK(late.await_resume().value() == 12);
+  }
+  {
+    // Failures are shared too
+    event e;
+    auto s = fetch(e, "");
+    auto c1 = consumer(s), c2 = consumer(s);
+    c1._h.resume();
+    c2._h.resume();
+    e.fire();
+    BOOST_CHECK(c1.await_resume().error() == std::errc::invalid_argument);
+    BOOST_CHECK(c2.await_resume().error() == std::errc::invalid_argument);
+  }
+  {
+    // A computation nobody awaits never runs
+    event e;
+    runs = 0;
+    {
+      auto s = fetch(e, "foo");
+      auto s2 = s;
+      shared_lazy<result<std::string>> s3;
+      s3 = std::move(s2);
+      BOOST_CHECK(s3);
+      BOOST_CHECK(!s2);
+    }
+    BOOST_CHECK(runs == 0);
+    BOOST_CHECK(alive == 0);
+  }
+  {
+    // Consumers on many threads
+    runs = 0;
+    auto s = [](int x) -> shared_lazy<result<int>> {
+      ++runs;
+      std::this_thread::yield();
+      co_return x;
+    }(42);
+    std::vector<std::thread> threads;
+    std::atomic<int> total{0};
+    for(int n = 0; n < 8; n++)
+    {
+      threads.emplace_back([&] {
+        auto r = awaitables::sync_wait([](shared_lazy<result<int>> s) -> atomic_lazy<result<int>> { co_return co_await s; }(s));
+        total += r.value();
+      });
+    }
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+    BOOST_CHECK(runs == 1);
+    BOOST_CHECK(total == 8 * 42);
+  }
+  {
+    // Awaiting a void computation twice runs it once
+    runs = 0;
+    shared_lazy<void> v = []() -> shared_lazy<void> {
+      ++runs;
+      co_return;
+    }();
+    auto t = [](shared_lazy<void> v) -> lazy<result<int>> {
+      co_await v;
+      co_await v;
+      co_return 1;
+    }(v);
+    t._h.resume();
+    BOOST_CHECK(t.await_resume().value() == 1);
+    BOOST_CHECK(runs == 1);
+  }
+}
+
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
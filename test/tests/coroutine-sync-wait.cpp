@@ -0,0 +1,130 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/coroutine_support.hpp"
+#include "../../include/outcome.hpp"
+
+#ifdef OUTCOME_FOUND_COROUTINE_HEADER
+
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace coroutine_sync_wait
+{
+  namespace awaitables = OUTCOME_V2_NAMESPACE::awaitables;
+  template <class T> using atomic_eager = awaitables::atomic_eager<T>;
+  template <class T> using atomic_lazy = awaitables::atomic_lazy<T>;
+  template <class T, class E = std::error_code> using result = OUTCOME_V2_NAMESPACE::result<T, E>;
+
+  // Resumes the awaiting coroutine on a new thread, after a delay
+  struct on_new_thread
+  {
+    std::thread &thread;
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(awaitables::coroutine_handle<> h)
+    {
+      thread = std::thread([h] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        h.resume();
+      });
+    }
+    void await_resume() noexcept {}
+  };
+
+  inline atomic_lazy<result<int>> value(int x) { co_return x; }
+  inline atomic_lazy<result<int>> value_on_new_thread(std::thread &thread, int x)
+  {
+    co_await on_new_thread{thread};
+    co_return x;
+  }
+  inline atomic_eager<result<int>> eager_value_on_new_thread(std::thread &thread, int x)
+  {
+    co_await on_new_thread{thread};
+    co_return x;
+  }
+  inline atomic_lazy<void> nothing_on_new_thread(std::thread &thread, bool &done)
+  {
+    co_await on_new_thread{thread};
+    done = true;
+  }
+  inline atomic_lazy<result<int>> cancelled(awaitables::cancellation_token /*unused*/, std::thread &thread)
+  {
+    co_await on_new_thread{thread};
+    co_return 1;
+  }
+}  // namespace coroutine_sync_wait
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / coroutine / sync_wait, "Tests that sync_wait() blocks until an atomic awaitable completes")
+{
+  using namespace coroutine_sync_wait;
+  using awaitables::sync_wait;
+  // A lazy which never suspends runs to completion on this thread
+  BOOST_CHECK(sync_wait(value(5)).value() == 5);
+  for(int n = 0; n < 10; n++)
+  {
+    // A lazy completing on another thread
+    std::thread thread;
+    BOOST_CHECK(sync_wait(value_on_new_thread(thread, n)).value() == n);
+    thread.join();
+  }
+  for(int n = 0; n < 10; n++)
+  {
+    // An eager already running, and completing on another thread
+    std::thread thread;
+    auto t = eager_value_on_new_thread(thread, n);
+    BOOST_CHECK(sync_wait(std::move(t)).value() == n);
+    thread.join();
+  }
+  {
+    // An eager which has already completed does not block
+    std::thread thread;
+    auto t = eager_value_on_new_thread(thread, 6);
+    thread.join();
+    BOOST_CHECK(sync_wait(std::move(t)).value() == 6);
+  }
+  {
+    std::thread thread;
+    bool done = false;
+    sync_wait(nothing_on_new_thread(thread, done));
+    BOOST_CHECK(done);
+    thread.join();
+  }
+  {
+    // A lazy cancelled before it suspends completes early
+    awaitables::cancellation_source src;
+    src.request_cancellation();
+    std::thread thread;
+    BOOST_CHECK(sync_wait(cancelled(src.token(), thread)).error() == std::errc::operation_canceled);
+    BOOST_CHECK(!thread.joinable());
+  }
+}
+
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
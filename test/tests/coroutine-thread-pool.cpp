@@ -0,0 +1,162 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/coroutine_support.hpp"
+#include "../../include/outcome/thread_pool.hpp"
+#include "../../include/outcome.hpp"
+
+#if OUTCOME_FOUND_COROUTINE_HEADER && OUTCOME_HAVE_NOOP_COROUTINE
+
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace coroutine_thread_pool
+{
+  namespace awaitables = OUTCOME_V2_NAMESPACE::awaitables;
+  template <class T> using atomic_lazy = awaitables::atomic_lazy<T>;
+  template <class T, class E = std::error_code> using result = OUTCOME_V2_NAMESPACE::result<T, E>;
+
+  template <class Spawned> inline auto wait(Spawned &s)
+  {
+    while(!s.await_ready())
+    {
+      std::this_thread::yield();
+    }
+    return s.await_resume();
+  }
+
+  inline atomic_lazy<result<std::thread::id>> where(awaitables::thread_pool &pool)
+  {
+    co_await pool.schedule();
+    co_return std::this_thread::get_id();
+  }
+  inline atomic_lazy<result<int>> square(int x)
+  {
+    if(x < 0)
+    {
+      co_return std::errc::invalid_argument;
+    }
+    co_return x *x;
+  }
+  // The threads which ran the children of sum_of_squares()
+  struct thread_ids
+  {
+    std::mutex lock;
+    std::set<std::thread::id> ids;
+
+    void record()
+    {
+      std::lock_guard<std::mutex> g(lock);
+      ids.insert(std::this_thread::get_id());
+    }
+    size_t size()
+    {
+      std::lock_guard<std::mutex> g(lock);
+      return ids.size();
+    }
+  };
+  inline atomic_lazy<result<int>> recorded_square(thread_ids &ran_on, int x)
+  {
+    ran_on.record();
+    std::this_thread::yield();  // give the other workers a chance to steal, even on one CPU
+    co_return x *x;
+  }
+  inline atomic_lazy<result<long>> sum_of_squares(awaitables::thread_pool &pool, thread_ids &ran_on, int n)
+  {
+    std::vector<decltype(pool.spawn(recorded_square(ran_on, 0)))> children;
+    children.reserve(n);
+    for(int x = 0; x < n; x++)
+    {
+      children.push_back(pool.spawn(recorded_square(ran_on, x)));
+    }
+    long ret = 0;
+    for(auto &c : children)
+    {
+      OUTCOME_CO_TRY(auto v, co_await c);
+      ret += v;
+    }
+    co_return ret;
+  }
+}  // namespace coroutine_thread_pool
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / coroutine / thread_pool, "Tests that the work stealing thread pool runs spawned lazy results")
+{
+  using namespace coroutine_thread_pool;
+  {
+    // schedule() resumes on a worker thread
+    awaitables::thread_pool pool(2);
+    BOOST_CHECK(pool.size() == 2);
+    auto s = pool.spawn(where(pool));
+    auto r = wait(s);
+    BOOST_REQUIRE(r.has_value());
+    BOOST_CHECK(r.value() != std::this_thread::get_id());
+  }
+  {
+    // Children spawned from within the pool are pushed onto the local deque, and stolen by the other workers
+    awaitables::thread_pool pool(4);
+    thread_ids ran_on;
+    for(int n = 0; n < 20; n++)
+    {
+      auto s = pool.spawn(sum_of_squares(pool, ran_on, 1000));
+      auto r = wait(s);
+      BOOST_REQUIRE(r.has_value());
+      BOOST_CHECK(r.value() == 332833500L);
+    }
+    BOOST_CHECK(ran_on.size() > 1);
+  }
+  {
+    // Failures propagate through spawn()
+    awaitables::thread_pool pool(2);
+    auto s = pool.spawn(square(-1));
+    auto r = wait(s);
+    BOOST_CHECK(r.error() == std::errc::invalid_argument);
+  }
+  {
+    // Spawned tasks which are never awaited are run to completion before the pool is destroyed
+    std::atomic<int> done{0};
+    {
+      awaitables::thread_pool pool(3);
+      for(int n = 0; n < 100; n++)
+      {
+        auto s = pool.spawn([](std::atomic<int> &done) -> atomic_lazy<result<void>> {
+          ++done;
+          co_return OUTCOME_V2_NAMESPACE::success();
+        }(done));
+        (void) s;
+      }
+    }
+    BOOST_CHECK(done == 100);
+  }
+}
+
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
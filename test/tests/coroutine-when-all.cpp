@@ -0,0 +1,253 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/coroutine_support.hpp"
+#include "../../include/outcome.hpp"
+
+#if OUTCOME_FOUND_COROUTINE_HEADER && OUTCOME_HAVE_NOOP_COROUTINE
+
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace coroutine_when_all
+{
+  namespace awaitables = OUTCOME_V2_NAMESPACE::awaitables;
+  template <class T> using lazy = awaitables::lazy<T>;
+  template <class T> using atomic_lazy = awaitables::atomic_lazy<T>;
+  template <class T, class E = std::error_code> using result = OUTCOME_V2_NAMESPACE::result<T, E>;
+
+  // Resumes its waiters when fired
+  struct event
+  {
+    std::vector<awaitables::coroutine_handle<>> waiters;
+    bool fired{false};
+
+    bool await_ready() const noexcept { return fired; }
+    void await_suspend(awaitables::coroutine_handle<> h) { waiters.push_back(h); }
+    void await_resume() noexcept {}
+    void fire()
+    {
+      fired = true;
+      auto w = std::move(waiters);
+      for(auto h : w)
+      {
+        h.resume();
+      }
+    }
+  };
+
+  // Counts the child frames still alive
+  static int started, alive;
+  struct frame_counter
+  {
+    frame_counter() noexcept { ++alive; }
+    frame_counter(const frame_counter &) = delete;
+    ~frame_counter() { --alive; }
+  };
+
+  inline lazy<result<int>> value(int x)
+  {
+    frame_counter c;
+    ++started;
+    co_return x;
+  }
+  inline lazy<result<std::string>> string_value(const char *x)
+  {
+    frame_counter c;
+    ++started;
+    co_return x;
+  }
+  inline lazy<result<void>> void_value()
+  {
+    frame_counter c;
+    ++started;
+    co_return OUTCOME_V2_NAMESPACE::success();
+  }
+  inline lazy<result<int>> error(std::errc ec)
+  {
+    frame_counter c;
+    ++started;
+    co_return ec;
+  }
+  inline lazy<result<int>> value_after(event &e, int x)
+  {
+    frame_counter c;
+    ++started;
+    co_await e;
+    co_return x;
+  }
+  inline lazy<result<int>> error_after(event &e, std::errc ec)
+  {
+    frame_counter c;
+    ++started;
+    co_await e;
+    co_return ec;
+  }
+
+  template <class T> inline auto run(T &&t)
+  {
+    if(!t.await_ready())
+    {
+      t._h.resume();
+    }
+    BOOST_CHECK(t.await_ready());
+    return t.await_resume();
+  }
+}  // namespace coroutine_when_all
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / coroutine / when_all, "Tests that when_all() awaits many lazy results, finishing on the first failure")
+{
+  using namespace coroutine_when_all;
+  using awaitables::when_all;
+  {
+    // All succeed, values are returned as a tuple
+    auto r = run([]() -> lazy<result<std::tuple<int, std::string, OUTCOME_V2_NAMESPACE::success_type<void>>>> { co_return co_await when_all(value(5), string_value("hi"), void_value()); }());
+    BOOST_REQUIRE(r.has_value());
+    BOOST_CHECK(std::get<0>(r.value()) == 5);
+    BOOST_CHECK(std::get<1>(r.value()) == "hi");
+    BOOST_CHECK(alive == 0);
+  }
+  {
+    // A synchronous failure means the remaining children are never started
+    started = 0;
+    auto r = run([]() -> lazy<result<std::tuple<int, int, int>>> { co_return co_await when_all(value(5), error(std::errc::io_error), value(6)); }());
+    BOOST_REQUIRE(r.has_error());
+    BOOST_CHECK(r.error() == std::errc::io_error);
+    BOOST_CHECK(started == 2);
+    BOOST_CHECK(alive == 0);
+  }
+  {
+    // All children are started before any complete, and the awaiter resumes when the last completes
+    started = 0;
+    event e1, e2;
+    auto t = [](event &e1, event &e2) -> lazy<result<std::tuple<int, int>>> { co_return co_await when_all(value_after(e1, 1), value_after(e2, 2)); }(e1, e2);
+    t._h.resume();
+    BOOST_CHECK(started == 2);
+    BOOST_CHECK(!t.await_ready());
+    e2.fire();
+    BOOST_CHECK(!t.await_ready());
+    e1.fire();
+    BOOST_REQUIRE(t.await_ready());
+    auto r = t.await_resume();
+    BOOST_REQUIRE(r.has_value());
+    BOOST_CHECK(std::get<0>(r.value()) == 1);
+    BOOST_CHECK(std::get<1>(r.value()) == 2);
+  }
+  BOOST_CHECK(alive == 0);
+  {
+    // The first failure resumes the awaiter, without waiting for the others which finish detached
+    event e1, e2;
+    auto t = [](event &e1, event &e2) -> lazy<result<std::tuple<int, int>>> { co_return co_await when_all(value_after(e1, 1), error_after(e2, std::errc::timed_out)); }(e1, e2);
+    t._h.resume();
+    BOOST_CHECK(alive == 2);
+    e2.fire();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().error() == std::errc::timed_out);
+    BOOST_CHECK(alive == 1);
+    e1.fire();
+    BOOST_CHECK(alive == 0);
+  }
+  {
+    // The range form returns a vector of values
+    std::vector<lazy<result<int>>> children;
+    for(int n = 0; n < 10; n++)
+    {
+      children.push_back(value(n));
+    }
+    auto r = run([](std::vector<lazy<result<int>>> children) -> lazy<result<std::vector<int>>> { co_return co_await when_all(std::move(children)); }(std::move(children)));
+    BOOST_REQUIRE(r.has_value());
+    BOOST_REQUIRE(r.value().size() == 10);
+    for(int n = 0; n < 10; n++)
+    {
+      BOOST_CHECK(r.value()[n] == n);
+    }
+    std::vector<lazy<result<int>>> failing;
+    failing.push_back(value(1));
+    failing.push_back(error(std::errc::invalid_argument));
+    auto r2 = run([](std::vector<lazy<result<int>>> children) -> lazy<result<std::vector<int>>> { co_return co_await when_all(std::move(children)); }(std::move(failing)));
+    BOOST_CHECK(r2.error() == std::errc::invalid_argument);
+    BOOST_CHECK(run([]() -> lazy<result<std::vector<int>>> { co_return co_await when_all(std::vector<lazy<result<int>>>()); }()).value().empty());
+  }
+  BOOST_CHECK(alive == 0);
+  {
+    // Children resumed concurrently by other threads
+    struct on_new_thread
+    {
+      std::vector<std::thread> &threads;
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(awaitables::coroutine_handle<> h)
+      {
+        threads.emplace_back([h] { h.resume(); });
+      }
+      void await_resume() noexcept {}
+    };
+    for(int n = 0; n < 100; n++)
+    {
+      std::vector<std::thread> threads;
+      threads.reserve(4);
+      auto child = [](std::vector<std::thread> &threads, int x) -> atomic_lazy<result<int>> {
+        co_await on_new_thread{threads};
+        if(x == 2)
+        {
+          co_return std::errc::io_error;
+        }
+        co_return x;
+      };
+      std::atomic<bool> done{false};
+      auto t = [](auto child, std::vector<std::thread> &threads, int n, std::atomic<bool> &done) -> atomic_lazy<result<std::tuple<int, int, int>>> {
+        auto r = co_await when_all(child(threads, 0), child(threads, 1), child(threads, (n & 1) ? 2 : 3));
+        done = true;
+        co_return r;
+      }(child, threads, n, done);
+      t._h.resume();
+      while(!done)
+      {
+        std::this_thread::yield();
+      }
+      for(auto &thread : threads)
+      {
+        thread.join();
+      }
+      BOOST_REQUIRE(t.await_ready());
+      auto r = t.await_resume();
+      if(n & 1)
+      {
+        BOOST_CHECK(r.error() == std::errc::io_error);
+      }
+      else
+      {
+        BOOST_CHECK(std::get<2>(r.value()) == 3);
+      }
+    }
+  }
+}
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
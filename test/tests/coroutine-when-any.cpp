@@ -0,0 +1,191 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/coroutine_support.hpp"
+#include "../../include/outcome.hpp"
+
+#if OUTCOME_FOUND_COROUTINE_HEADER && OUTCOME_HAVE_NOOP_COROUTINE
+
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace coroutine_when_any
+{
+  namespace awaitables = OUTCOME_V2_NAMESPACE::awaitables;
+  template <class T> using lazy = awaitables::lazy<T>;
+  template <class T> using atomic_lazy = awaitables::atomic_lazy<T>;
+  template <class T, class E = std::error_code> using result = OUTCOME_V2_NAMESPACE::result<T, E>;
+
+  // Resumes its waiters when fired
+  struct event
+  {
+    std::vector<awaitables::coroutine_handle<>> waiters;
+    bool fired{false};
+
+    bool await_ready() const noexcept { return fired; }
+    void await_suspend(awaitables::coroutine_handle<> h) { waiters.push_back(h); }
+    void await_resume() noexcept {}
+    void fire()
+    {
+      fired = true;
+      auto w = std::move(waiters);
+      for(auto h : w)
+      {
+        h.resume();
+      }
+    }
+  };
+
+  // Counts the child frames still alive
+  static std::atomic<int> started, alive;
+  struct frame_counter
+  {
+    frame_counter() noexcept { ++alive; }
+    frame_counter(const frame_counter &) = delete;
+    ~frame_counter() { --alive; }
+  };
+
+  inline atomic_lazy<result<int>> value(int x)
+  {
+    frame_counter c;
+    ++started;
+    co_return x;
+  }
+  inline atomic_lazy<result<int>> value_after(event &e, int x)
+  {
+    frame_counter c;
+    ++started;
+    co_await e;
+    co_return x;
+  }
+  inline atomic_lazy<result<int>> error_after(event &e, std::errc ec)
+  {
+    frame_counter c;
+    ++started;
+    co_await e;
+    co_return ec;
+  }
+}  // namespace coroutine_when_any
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / coroutine / when_any, "Tests that when_any() returns the first value, or the last failure, of many lazy results")
+{
+  using namespace coroutine_when_any;
+  using awaitables::when_any;
+  {
+    // A synchronous success means the remaining children are never started
+    auto t = []() -> lazy<result<int>> { co_return co_await when_any(value(5), value(6)); }();
+    t._h.resume();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 5);
+    BOOST_CHECK(started == 1);
+    BOOST_CHECK(alive == 0);
+  }
+  {
+    // Failures are ignored until the last, the first value wins and the rest finish detached
+    event e1, e2, e3;
+    auto t = [](event &e1, event &e2, event &e3) -> lazy<result<int>> { co_return co_await when_any(error_after(e1, std::errc::io_error), value_after(e2, 2), value_after(e3, 3)); }(e1, e2, e3);
+    t._h.resume();
+    BOOST_CHECK(alive == 3);
+    e1.fire();
+    BOOST_CHECK(!t.await_ready());
+    e2.fire();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 2);
+    BOOST_CHECK(alive == 1);
+    e3.fire();
+    BOOST_CHECK(alive == 0);
+  }
+  {
+    // If all fail, the last failure is returned
+    event e1, e2;
+    auto t = [](event &e1, event &e2) -> lazy<result<int>> { co_return co_await when_any(error_after(e1, std::errc::io_error), error_after(e2, std::errc::timed_out)); }(e1, e2);
+    t._h.resume();
+    e2.fire();
+    BOOST_CHECK(!t.await_ready());
+    e1.fire();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().error() == std::errc::io_error);
+    BOOST_CHECK(alive == 0);
+  }
+  {
+    // Replicas racing on other threads
+    struct on_new_thread
+    {
+      std::vector<std::thread> &threads;
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(awaitables::coroutine_handle<> h)
+      {
+        threads.emplace_back([h] { h.resume(); });
+      }
+      void await_resume() noexcept {}
+    };
+    for(int n = 0; n < 100; n++)
+    {
+      std::vector<std::thread> threads;
+      threads.reserve(8);
+      auto replica = [](std::vector<std::thread> &threads, int x) -> atomic_lazy<result<int>> {
+        frame_counter c;
+        co_await on_new_thread{threads};
+        if(x & 1)
+        {
+          co_return std::errc::io_error;
+        }
+        co_return x;
+      };
+      std::vector<atomic_lazy<result<int>>> replicas;
+      for(int i = 0; i < 8; i++)
+      {
+        replicas.push_back(replica(threads, n + i));
+      }
+      std::atomic<bool> done{false};
+      auto t = [](std::vector<atomic_lazy<result<int>>> replicas, std::atomic<bool> &done) -> atomic_lazy<result<int>> {
+        auto r = co_await when_any(std::move(replicas));
+        done = true;
+        co_return r;
+      }(std::move(replicas), done);
+      t._h.resume();
+      while(!done)
+      {
+        std::this_thread::yield();
+      }
+      BOOST_REQUIRE(t.await_ready());
+      auto r = t.await_resume();
+      BOOST_REQUIRE(r.has_value());
+      BOOST_CHECK((r.value() & 1) == 0);
+      for(auto &thread : threads)
+      {
+        thread.join();
+      }
+      BOOST_CHECK(alive == 0);
+    }
+  }
+}
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,97 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/utils.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <ios>
+
+namespace error_from_exception_test
+{
+  struct custom_error : std::runtime_error
+  {
+    int code;
+    custom_error(int c)
+        : std::runtime_error("custom")
+        , code(c)
+    {
+    }
+  };
+  struct derived_custom_error : custom_error
+  {
+    derived_custom_error()
+        : custom_error(EPERM)
+    {
+    }
+  };
+}  // namespace error_from_exception_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / error_from_exception, "Tests that error_from_exception classifies exceptions")
+{
+#ifdef __cpp_exceptions
+  using namespace OUTCOME_V2_NAMESPACE;
+  using error_from_exception_test::custom_error;
+  using error_from_exception_test::derived_custom_error;
+
+  auto classify = [](auto &&e) {
+    auto ep = std::make_exception_ptr(e);
+    auto ec = error_from_exception(std::move(ep), std::make_error_code(std::errc::not_supported));
+    // A matched exception is consumed
+    BOOST_CHECK(!ep == (ec != std::errc::not_supported));
+    return ec;
+  };
+
+  // The standard exception types, including via their base classes
+  BOOST_CHECK(classify(std::invalid_argument("")) == std::errc::invalid_argument);
+  BOOST_CHECK(classify(std::domain_error("")) == std::errc::argument_out_of_domain);
+  BOOST_CHECK(classify(std::length_error("")) == std::errc::argument_list_too_long);
+  BOOST_CHECK(classify(std::out_of_range("")) == std::errc::result_out_of_range);
+  BOOST_CHECK(classify(std::logic_error("")) == std::errc::invalid_argument);
+  BOOST_CHECK(classify(std::system_error(std::make_error_code(std::errc::io_error))) == std::errc::io_error);
+  BOOST_CHECK(classify(std::ios_base::failure("", std::make_error_code(std::errc::broken_pipe))) == std::errc::broken_pipe);
+  BOOST_CHECK(classify(std::overflow_error("")) == std::errc::value_too_large);
+  BOOST_CHECK(classify(std::range_error("")) == std::errc::result_out_of_range);
+  BOOST_CHECK(classify(std::runtime_error("")) == std::errc::resource_unavailable_try_again);
+  BOOST_CHECK(classify(std::bad_alloc()) == std::errc::not_enough_memory);
+  BOOST_CHECK(classify(custom_error(EACCES)) == std::errc::resource_unavailable_try_again);
+  BOOST_CHECK(classify(5) == std::errc::not_supported);
+  BOOST_CHECK(!error_from_exception(std::exception_ptr()));
+
+  // User registered types take precedence over the standard types
+  BOOST_CHECK(register_error_from_exception<custom_error>([](const custom_error &e) { return std::error_code(e.code, std::generic_category()); }));
+  BOOST_CHECK(classify(custom_error(EACCES)) == std::errc::permission_denied);
+  BOOST_CHECK(classify(derived_custom_error()) == std::errc::operation_not_permitted);
+  BOOST_CHECK(classify(std::runtime_error("")) == std::errc::resource_unavailable_try_again);
+
+  // Also works with the exception currently being handled
+  try
+  {
+    throw std::out_of_range("");
+  }
+  catch(...)
+  {
+    BOOST_CHECK(error_from_exception() == std::errc::result_out_of_range);
+  }
+#endif
+}
@@ -35,6 +35,73 @@ using OUTCOME_V2_NAMESPACE::in_place_type;
 #pragma warning(disable : 4702)  // unreachable code
 #endif
 
+#ifdef __cpp_exceptions
+namespace status_outcome_test
+{
+  // The exception thrown by codes of custom_domain<Id>
+  template <unsigned long long Id> struct custom_exception : std::exception
+  {
+    int value;
+    explicit custom_exception(int v)
+        : value(v)
+    {
+    }
+    virtual const char *what() const noexcept override final { return "custom exception"; }  // NOLINT
+  };
+
+  // A domain whose codes throw custom_exception<Id> rather than status_error
+  template <unsigned long long Id> class custom_domain : public SYSTEM_ERROR2_NAMESPACE::status_code_domain
+  {
+    template <class> friend class SYSTEM_ERROR2_NAMESPACE::status_code;
+    using _base = SYSTEM_ERROR2_NAMESPACE::status_code_domain;
+    using _code = SYSTEM_ERROR2_NAMESPACE::status_code<custom_domain>;
+
+  public:
+    using value_type = int;
+    using string_ref = _base::string_ref;
+
+    constexpr custom_domain() noexcept
+        : _base(Id)
+    {
+    }
+    static inline constexpr const custom_domain &get();
+
+    virtual _base::string_ref name() const noexcept override final { return string_ref("custom domain"); }  // NOLINT
+  protected:
+    virtual bool _do_failure(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code) const noexcept override final  // NOLINT
+    {
+      return static_cast<const _code &>(code).value() != 0;  // NOLINT
+    }
+    virtual bool _do_equivalent(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code1, const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code2) const noexcept override final  // NOLINT
+    {
+      return code2.domain() == *this && static_cast<const _code &>(code1).value() == static_cast<const _code &>(code2).value();  // NOLINT
+    }
+    virtual SYSTEM_ERROR2_NAMESPACE::generic_code _generic_code(const SYSTEM_ERROR2_NAMESPACE::status_code<void> & /*unused*/) const noexcept override final  // NOLINT
+    {
+      return SYSTEM_ERROR2_NAMESPACE::errc::unknown;
+    }
+    virtual _base::string_ref _do_message(const SYSTEM_ERROR2_NAMESPACE::status_code<void> & /*unused*/) const noexcept override final { return string_ref("custom code"); }  // NOLINT
+    virtual void _do_throw_exception(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code) const override final  // NOLINT
+    {
+      throw custom_exception<Id>(static_cast<const _code &>(code).value());  // NOLINT
+    }
+  };
+  template <unsigned long long Id> constexpr custom_domain<Id> custom_domain_v{};
+  template <unsigned long long Id> inline constexpr const custom_domain<Id> &custom_domain<Id>::get() { return custom_domain_v<Id>; }
+
+  using thrown_code = SYSTEM_ERROR2_NAMESPACE::status_code<custom_domain<0x5d2f0a5b6c1e4a01>>;
+  using hooked_code = SYSTEM_ERROR2_NAMESPACE::status_code<custom_domain<0x5d2f0a5b6c1e4a02>>;
+
+  // The hook lets failure() construct the exception of hooked_code directly
+  static int hook_calls;
+  inline custom_exception<0x5d2f0a5b6c1e4a02> status_code_exception_from_error(const hooked_code &sc)
+  {
+    ++hook_calls;
+    return custom_exception<0x5d2f0a5b6c1e4a02>(sc.value());
+  }
+}  // namespace status_outcome_test
+#endif
+
 BOOST_OUTCOME_AUTO_TEST_CASE(works / status_code / outcome, "Tests that the outcome with status_code works as intended")
 {
   using namespace SYSTEM_ERROR2_NAMESPACE;
@@ -216,3 +283,88 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works / status_code / outcome, "Tests that the outc
     BOOST_CHECK(h.has_value());
   }
 }
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / status_code / outcome / failure, "Tests that failure() of an errored status_outcome constructs and caches its exception")
+{
+  using namespace SYSTEM_ERROR2_NAMESPACE;
+#ifdef __cpp_exceptions
+  {  // erased code of a built in domain
+    outcome<int> m(generic_code{errc::bad_address}), n(generic_code{errc::bad_address}), o(generic_code{errc::invalid_argument});
+    auto e = m.failure();
+    BOOST_CHECK(e);
+    // Code only errors share the same immutable exception
+    BOOST_CHECK(e == n.failure());
+    BOOST_CHECK(e != o.failure());
+    try
+    {
+      OUTCOME_PREVENT_CONVERSION_WORKAROUND::rethrow_exception(e);
+    }
+    catch(const generic_error &ex)
+    {
+      BOOST_CHECK(ex.code() == errc::bad_address);
+    }
+  }
+  {  // typed code
+    outcome<int, generic_code> m(generic_code{errc::bad_address});
+    auto e = m.failure();
+    BOOST_CHECK(e == m.failure());
+    BOOST_CHECK_THROW(OUTCOME_PREVENT_CONVERSION_WORKAROUND::rethrow_exception(e), generic_error);
+  }
+#ifndef _WIN32
+  {  // erased posix code
+    outcome<int> m(posix_code(EINVAL));
+    BOOST_CHECK_THROW(OUTCOME_PREVENT_CONVERSION_WORKAROUND::rethrow_exception(m.failure()), status_error<_posix_code_domain>);
+  }
+#endif
+  {  // erased indirecting codes must not be cached by their heap pointer, which is reused once freed
+    auto failure_of = [](int errcode) {
+      outcome<int> m(make_status_code_ptr(generic_code(static_cast<errc>(errcode))));
+      return m.failure();
+    };
+    auto e1 = failure_of(EINVAL);
+    auto e2 = failure_of(ENOENT);
+    BOOST_CHECK(e1 != e2);
+    try
+    {
+      OUTCOME_PREVENT_CONVERSION_WORKAROUND::rethrow_exception(e2);
+    }
+    catch(const generic_error &ex)
+    {
+      BOOST_CHECK(ex.code() == errc::no_such_file_or_directory);
+    }
+  }
+  {  // typed codes of domains neither registered nor with a hook get the exception their domain throws
+    using status_outcome_test::thrown_code;
+    static_assert(!OUTCOME_V2_NAMESPACE::detail::has_status_code_exception_hook<thrown_code::domain_type>::value, "");
+    outcome<int, thrown_code> m(thrown_code(in_place, 5));
+    try
+    {
+      OUTCOME_PREVENT_CONVERSION_WORKAROUND::rethrow_exception(m.failure());
+      BOOST_CHECK(false);
+    }
+    catch(const status_outcome_test::custom_exception<0x5d2f0a5b6c1e4a01> &ex)
+    {
+      BOOST_CHECK(ex.value == 5);
+    }
+    catch(...)
+    {
+      BOOST_CHECK(false);
+    }
+  }
+  {  // those of domains with a hook use it, both typed and erased
+    using status_outcome_test::hooked_code;
+    using exception_type = status_outcome_test::custom_exception<0x5d2f0a5b6c1e4a02>;
+    static_assert(OUTCOME_V2_NAMESPACE::detail::has_status_code_exception_hook<hooked_code::domain_type>::value, "");
+    outcome<int, hooked_code> m(hooked_code(in_place, 6));
+    auto e = m.failure();
+    BOOST_CHECK(status_outcome_test::hook_calls == 1);
+    BOOST_CHECK(e == m.failure());
+    BOOST_CHECK_THROW(OUTCOME_PREVENT_CONVERSION_WORKAROUND::rethrow_exception(e), exception_type);
+    BOOST_CHECK(OUTCOME_V2_NAMESPACE::experimental::register_status_code_exception_domain<hooked_code::domain_type>());
+    outcome<int> n(hooked_code(in_place, 7));
+    BOOST_CHECK_THROW(OUTCOME_PREVENT_CONVERSION_WORKAROUND::rethrow_exception(n.failure()), exception_type);
+    BOOST_CHECK(status_outcome_test::hook_calls == 2);
+  }
+  BOOST_CHECK(OUTCOME_V2_NAMESPACE::experimental::register_status_code_exception_domain<_generic_code_domain>());
+#endif
+}
@@ -276,6 +276,10 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works / status_code / result, "Tests that the resul
 #endif
     static_assert(!std::is_trivially_destructible<decltype(a)>::value, "");
     static_assert(std::is_nothrow_destructible<decltype(a)>::value, "");
+#ifndef TESTING_WG21_EXPERIMENTAL_RESULT
+    // The erased status code is move bitcopying, so the result can be relocated with memcpy
+    static_assert(OUTCOME_V2_NAMESPACE::trait::is_trivially_relocatable<decltype(a)>::value, "");
+#endif
 
     // Test void compiles
     result<void> c(in_place_type<void>);
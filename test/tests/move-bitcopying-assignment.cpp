@@ -0,0 +1,123 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+namespace move_bitcopying_assignment
+{
+  static int live;
+
+  // Counts its live instances. Moves leave the source disengaged, so it is move bitcopying
+  template <int tag> struct counted
+  {
+    bool engaged{false};
+    explicit counted(int /*unused*/)
+        : engaged(true)
+    {
+      ++live;
+    }
+    counted(counted &&o) noexcept
+        : engaged(o.engaged)
+    {
+      o.engaged = false;
+    }
+    counted(const counted &o)
+        : engaged(o.engaged)
+    {
+      if(engaged)
+      {
+        ++live;
+      }
+    }
+    counted &operator=(counted &&o) noexcept
+    {
+      std::swap(engaged, o.engaged);
+      return *this;
+    }
+    counted &operator=(const counted &o)
+    {
+      counted temp(o);
+      std::swap(engaged, temp.engaged);
+      return *this;
+    }
+    ~counted()
+    {
+      if(engaged)
+      {
+        --live;
+      }
+    }
+  };
+}  // namespace move_bitcopying_assignment
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <int tag> struct is_move_bitcopying<move_bitcopying_assignment::counted<tag>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+OUTCOME_V2_NAMESPACE_END
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / move_bitcopying / assignment, "Tests that assigning over a move bitcopying value or error destroys it")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using move_bitcopying_assignment::live;
+  using value_type = move_bitcopying_assignment::counted<0>;
+  using error_type = move_bitcopying_assignment::counted<1>;
+  using result_type = result<value_type, error_type, policy::terminate>;
+  static_assert(trait::is_move_bitcopying<value_type>::value, "counted is not move bitcopying");
+
+  live = 0;
+  {
+    // Copy assigning an error over a value, and a value over an error
+    result_type a(in_place_type<value_type>, 1), b(in_place_type<error_type>, 2);
+    BOOST_CHECK(live == 2);
+    a = b;
+    BOOST_CHECK(a.has_error());
+    BOOST_CHECK(live == 2);
+    result_type c(in_place_type<value_type>, 3);
+    BOOST_CHECK(live == 3);
+    b = c;
+    BOOST_CHECK(b.has_value());
+    BOOST_CHECK(live == 3);
+  }
+  BOOST_CHECK(live == 0);
+  {
+    // Move assigning an error over a value, and a value over an error
+    result_type a(in_place_type<value_type>, 1), b(in_place_type<error_type>, 2);
+    BOOST_CHECK(live == 2);
+    a = std::move(b);
+    BOOST_CHECK(a.has_error());
+    BOOST_CHECK(live == 1);
+    result_type c(in_place_type<value_type>, 3);
+    BOOST_CHECK(live == 2);
+    a = std::move(c);
+    BOOST_CHECK(a.has_value());
+    BOOST_CHECK(live == 1);
+  }
+  BOOST_CHECK(live == 0);
+}
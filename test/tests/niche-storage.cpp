@@ -0,0 +1,157 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace niche_storage
+{
+  struct category
+  {
+    const char *name;
+  };
+  static const category generic_category{"generic"};
+
+  // Too big to fit before the niche
+  struct wide
+  {
+    int64_t a[2];
+    wide(int v) noexcept  // NOLINT
+        : a{v, v}
+    {
+    }
+    operator int() const noexcept { return static_cast<int>(a[0]); }  // NOLINT
+  };
+
+  // The category pointer of a live error is never null
+  struct error
+  {
+    int code;
+    const category *cat;
+    error(int c, const category &cat_) noexcept
+        : code(c)
+        , cat(&cat_)
+    {
+    }
+  };
+}  // namespace niche_storage
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct niche<niche_storage::error>
+  {
+    static constexpr bool value = true;
+    using word_type = uintptr_t;
+    static constexpr size_t offset = offsetof(niche_storage::error, cat);
+    static constexpr word_type invalid = 0;
+  };
+}  // namespace trait
+OUTCOME_V2_NAMESPACE_END
+
+namespace niche_storage
+{
+  template <class T> using result = OUTCOME_V2_NAMESPACE::result<T, error, OUTCOME_V2_NAMESPACE::policy::terminate>;
+}  // namespace niche_storage
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / niche, "Tests that result uses niche storage when the value or error has an impossible bit pattern")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using niche_storage::error;
+  using niche_storage::generic_category;
+  using niche_storage::result;
+  using niche_storage::wide;
+
+  // Fits in the bytes before the niche
+  static_assert(sizeof(result<int>) == sizeof(error), "result<int> did not use niche storage");
+  static_assert(sizeof(result<void>) == sizeof(error), "result<void> did not use niche storage");
+  static_assert(std::is_trivially_copyable<result<int>>::value, "result<int> is not trivially copyable");
+  // Overlaps the niche, so classic storage is used
+  static_assert(sizeof(result<wide>) > sizeof(wide), "result<wide> did not use classic storage");
+  static_assert(std::is_nothrow_move_constructible<result<std::unique_ptr<int>>>::value, "result<std::unique_ptr<int>> is not nothrow move");
+  static_assert(!std::is_copy_constructible<result<std::unique_ptr<int>>>::value, "result<std::unique_ptr<int>> is copy constructible");
+
+  {
+    result<int> a(5), b(error(6, generic_category));
+    BOOST_CHECK(a.has_value());
+    BOOST_CHECK(!a.has_error());
+    BOOST_CHECK(a.value() == 5);
+    BOOST_CHECK(!b.has_value());
+    BOOST_CHECK(b.has_error());
+    BOOST_CHECK(b.error().code == 6);
+    BOOST_CHECK(b.error().cat == &generic_category);
+    BOOST_CHECK(!a.has_exception());
+    BOOST_CHECK(!a.has_lost_consistency());
+
+    result<int> c(a);
+    BOOST_CHECK(c.value() == 5);
+    c = b;
+    BOOST_CHECK(c.has_error());
+    BOOST_CHECK(c.error().code == 6);
+    c = a;
+    BOOST_CHECK(c.value() == 5);
+    a.swap(b);
+    BOOST_CHECK(a.error().code == 6);
+    BOOST_CHECK(b.value() == 5);
+
+    // Spare storage is not available
+    hooks::set_spare_storage(&c, 78);
+    BOOST_CHECK(hooks::spare_storage(&c) == 0);
+
+    // Converting from niche to classic storage and back again preserves the state
+    result<wide> d(b), e(a);
+    BOOST_CHECK(d.value() == 5);
+    BOOST_CHECK(e.error().code == 6);
+    result<int> f(d), g(e);
+    BOOST_CHECK(f.value() == 5);
+    BOOST_CHECK(g.error().code == 6);
+  }
+  {
+    result<void> a(success()), b(error(7, generic_category));
+    BOOST_CHECK(a.has_value());
+    BOOST_CHECK(b.has_error());
+    BOOST_CHECK(b.error().code == 7);
+    a = b;
+    BOOST_CHECK(a.has_error());
+  }
+  {
+    // Non-trivial values work too
+    result<std::unique_ptr<int>> a(std::make_unique<int>(5)), b(error(6, generic_category));
+    BOOST_CHECK(sizeof(a) == sizeof(error));
+    BOOST_CHECK(*a.value() == 5);
+    BOOST_CHECK(b.error().code == 6);
+    a.swap(b);
+    BOOST_CHECK(a.has_error());
+    BOOST_CHECK(*b.value() == 5);
+    a = std::move(b);
+    BOOST_CHECK(*a.value() == 5);
+    result<std::unique_ptr<int>> c(std::move(a));
+    BOOST_CHECK(*c.value() == 5);
+    c = error(8, generic_category);
+    BOOST_CHECK(c.error().code == 8);
+  }
+}
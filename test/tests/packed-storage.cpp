@@ -0,0 +1,81 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#define OUTCOME_ENABLE_PACKED_STORAGE 1
+#include "../../include/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstdint>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / packed, "Tests that small trivial results are padded out to whole registers")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  struct udt
+  {
+    int32_t a, b;
+  };
+  enum class code : int8_t
+  {
+    bad = 6,
+    worse = 7
+  };
+  using small = result<int16_t, code, policy::terminate>;
+  using pair = result<udt, code, policy::terminate>;
+  using word = result<int32_t, code, policy::terminate>;
+  using large = result<int64_t, code, policy::terminate>;
+
+  // 6 and 12 bytes get padded out to 8 and 16
+  static_assert(sizeof(small) == 8, "small is not packed into 8 bytes");
+  static_assert(alignof(small) == 8, "small is not aligned to 8 bytes");
+  static_assert(sizeof(pair) == 16, "pair is not packed into 16 bytes");
+  static_assert(std::is_trivially_copyable<small>::value, "small is not trivially copyable");
+  static_assert(std::is_trivially_copyable<pair>::value, "pair is not trivially copyable");
+  // Already a whole number of registers, so left alone
+  static_assert(sizeof(word) == 8 && alignof(word) == 4, "word was packed");
+  static_assert(sizeof(large) == 16, "large was packed");
+
+  small a(int16_t(5)), b(code::bad);
+  BOOST_CHECK(a.value() == 5);
+  BOOST_CHECK(b.error() == code::bad);
+  hooks::set_spare_storage(&b, 78);
+  small c(b);
+  BOOST_CHECK(c.error() == code::bad);
+  BOOST_CHECK(hooks::spare_storage(&c) == 78);
+  a.swap(c);
+  BOOST_CHECK(a.error() == code::bad);
+  BOOST_CHECK(c.value() == 5);
+
+  pair d(udt{1, 2}), e(code::bad);
+  BOOST_CHECK(d.value().b == 2);
+  BOOST_CHECK(e.error() == code::bad);
+  d = e;
+  BOOST_CHECK(d.error() == code::bad);
+
+  // Conversion between packed and unpacked storage
+  word f(c), g(a);
+  BOOST_CHECK(f.value() == 5);
+  BOOST_CHECK(g.error() == code::bad);
+  BOOST_CHECK(hooks::spare_storage(&g) == 78);
+  small h(result<int8_t, code, policy::all_narrow>(code::worse));
+  BOOST_CHECK(h.error() == code::worse);
+}
@@ -0,0 +1,108 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/result_vector.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace result_status_scan
+{
+  // The pointer of a live error is never null, so results of it use niche storage
+  struct error
+  {
+    int code;
+    const char *msg;
+  };
+
+  // Checks the bulk scans for every length up to 40, failing at every index
+  template <class Result, class Success, class Failure> void check(Success &&success, Failure &&failure)
+  {
+    using namespace OUTCOME_V2_NAMESPACE;
+    for(size_t count = 0; count <= 40; count++)
+    {
+      std::vector<Result> v;
+      for(size_t idx = 0; idx < count; idx++)
+      {
+        v.push_back(success(idx));
+      }
+      BOOST_CHECK(all_valued(v));
+      BOOST_CHECK(first_failed_index(v) == count);
+      BOOST_CHECK(count_failed(v) == 0U);
+      // Fail from the back, so the latest failure is always the first
+      for(size_t idx = count; idx-- > 0;)
+      {
+        v[idx] = failure(idx);
+        BOOST_CHECK(!all_valued(v));
+        BOOST_CHECK(first_failed_index(v) == idx);
+        BOOST_CHECK(count_failed(v) == count - idx);
+        BOOST_CHECK(all_valued(v.data(), idx));
+      }
+    }
+  }
+}  // namespace result_status_scan
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct niche<result_status_scan::error>
+  {
+    static constexpr bool value = true;
+    using word_type = uintptr_t;
+    static constexpr size_t offset = offsetof(result_status_scan::error, msg);
+    static constexpr word_type invalid = 0;
+  };
+}  // namespace trait
+OUTCOME_V2_NAMESPACE_END
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / status_scan, "Tests that the bulk status scans over contiguous results work as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using result_status_scan::check;
+  using result_status_scan::error;
+
+  // Trivial storage, whose status sits after the value and error
+  check<result<int, long, policy::terminate>>([](size_t idx) { return success(static_cast<int>(idx)); }, [](size_t idx) { return failure(static_cast<long>(idx)); });
+  // Non-trivial storage, whose status sits between the value and error
+  check<result<std::string, std::error_code, policy::terminate>>([](size_t idx) { return success(std::to_string(idx)); },
+                                                                 [](size_t /*unused*/) { return failure(std::make_error_code(std::errc::invalid_argument)); });
+  // Niche storage, which has no status to load
+  static_assert(sizeof(result<int, error, policy::terminate>) == sizeof(error), "result<int, error> did not use niche storage");
+  check<result<int, error, policy::terminate>>([](size_t idx) { return success(static_cast<int>(idx)); }, [](size_t /*unused*/) { return failure(error{5, "failed"}); });
+
+  // Moved from results keep their status
+  {
+    std::array<result<std::string, int, policy::terminate>, 3> a{{std::string("a"), failure(1), std::string("c")}};
+    auto b = std::move(a);
+    BOOST_CHECK(first_failed_index(a) == 1U);
+    BOOST_CHECK(first_failed_index(b) == 1U);
+    BOOST_CHECK(count_failed(a.data(), a.size()) == 1U);
+    BOOST_CHECK(all_valued(a.data(), 1));
+    BOOST_CHECK(all_valued(static_cast<const result<std::string, int, policy::terminate> *>(nullptr), 0));
+  }
+}
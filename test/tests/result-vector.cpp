@@ -0,0 +1,173 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/result_vector.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace result_vector_test
+{
+  static bool throw_on_assign;
+
+  // A value whose assignment throws on request
+  struct fragile
+  {
+    int v{0};
+    fragile() = default;
+    explicit fragile(int _v)
+        : v(_v)
+    {
+    }
+    fragile(const fragile &) = default;
+    fragile(fragile &&) = default;
+    fragile &operator=(const fragile &o)
+    {
+      if(throw_on_assign)
+      {
+        throw std::runtime_error("assign");
+      }
+      v = o.v;
+      return *this;
+    }
+    fragile &operator=(fragile &&o)
+    {
+      if(throw_on_assign)
+      {
+        throw std::runtime_error("assign");
+      }
+      v = o.v;
+      return *this;
+    }
+  };
+}  // namespace result_vector_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result_vector, "Tests that result_vector works as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using error = std::errc;
+  result_vector<std::string, error, policy::terminate> v;
+  BOOST_CHECK(v.empty());
+  BOOST_CHECK(v.all_valued());
+  v.reserve(200);
+  for(int n = 0; n < 200; n++)
+  {
+    if(n % 50 == 7)
+    {
+      v.emplace_error(error::invalid_argument);
+    }
+    else
+    {
+      v.emplace_value(std::to_string(n));
+    }
+  }
+  BOOST_REQUIRE(v.size() == 200U);  // NOLINT
+  BOOST_CHECK(!v.all_valued());
+  BOOST_CHECK(v.count_failed() == 4U);
+  BOOST_CHECK(v.first_failed_index() == 7U);
+  BOOST_CHECK(v.status_bitmap().size() == 4U);
+  BOOST_CHECK(v.values().size() == 200U);
+  BOOST_CHECK(v.errors().size() == 4U);
+  BOOST_CHECK(v.errors()[1].first == 57U);
+
+  // Proxies behave like results
+  BOOST_CHECK(v[0].has_value());
+  BOOST_CHECK(v[0]);
+  BOOST_CHECK(v[0].value() == "0");
+  BOOST_CHECK(!v[7].has_value());
+  BOOST_CHECK(v[7].has_error());
+  BOOST_CHECK(v[7].error() == error::invalid_argument);
+  result<std::string, error, policy::terminate> r = v[107];
+  BOOST_CHECK(r.error() == error::invalid_argument);
+  r = v[108];
+  BOOST_CHECK(r.value() == "108");
+
+  // Assigning changes state, keeping the errors sorted
+  v[7] = std::string("seven");
+  BOOST_CHECK(v[7].value() == "seven");
+  BOOST_CHECK(v.count_failed() == 3U);
+  v[100] = failure(error::timed_out);
+  v[0] = failure(error::io_error);
+  BOOST_CHECK(v.count_failed() == 5U);
+  BOOST_CHECK(v.errors().front().first == 0U);
+  BOOST_CHECK(v[0].error() == error::io_error);
+  BOOST_CHECK(v[100].error() == error::timed_out);
+  BOOST_CHECK(v.values()[100].empty());
+  v[100] = failure(error::not_supported);
+  BOOST_CHECK(v[100].error() == error::not_supported);
+  BOOST_CHECK(v.count_failed() == 5U);
+  v[1] = v[0];
+  BOOST_CHECK(v[1].error() == error::io_error);
+  BOOST_CHECK(v.count_failed() == 6U);
+
+  // Iteration visits every element in order
+  size_t idx = 0, failed = 0;
+  for(auto i : v)
+  {
+    BOOST_CHECK(i.has_value() == v[idx].has_value());
+    failed += i.has_error();
+    ++idx;
+  }
+  BOOST_CHECK(idx == 200U);
+  BOOST_CHECK(failed == v.count_failed());
+
+  // Shrinking returns status words and errors
+  for(int n = 0; n < 193; n++)
+  {
+    v.pop_back();
+  }
+  BOOST_CHECK(v.size() == 7U);
+  BOOST_CHECK(v.status_bitmap().size() == 1U);
+  BOOST_CHECK(v.count_failed() == 2U);
+  v.push_back(failure(error::timed_out));
+  BOOST_CHECK(v.back().error() == error::timed_out);
+  v.clear();
+  BOOST_CHECK(v.empty());
+  BOOST_CHECK(v.all_valued());
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result_vector / exception_safety, "Tests that a throw while assigning an error over a value leaves result_vector unchanged")
+{
+#ifdef __cpp_exceptions
+  using namespace OUTCOME_V2_NAMESPACE;
+  using result_vector_test::fragile;
+  using error = std::errc;
+  using result_type = result<fragile, error, policy::terminate>;
+  result_vector<fragile, error, policy::terminate> v;
+  v.emplace_value(1);
+  v.emplace_error(error::io_error);
+  v.emplace_value(3);
+  result_vector_test::throw_on_assign = true;
+  BOOST_CHECK_THROW(v[0] = result_type(error::timed_out), std::runtime_error);
+  result_vector_test::throw_on_assign = false;
+  BOOST_CHECK(v[0].has_value());
+  BOOST_CHECK(v[0].value().v == 1);
+  BOOST_CHECK(v.count_failed() == 1U);
+  BOOST_CHECK(v.first_failed_index() == 1U);
+  v[0] = result_type(error::timed_out);
+  BOOST_CHECK(v[0].error() == error::timed_out);
+  BOOST_CHECK(v.count_failed() == 2U);
+#endif
+}
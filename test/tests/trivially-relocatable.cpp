@@ -0,0 +1,149 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <string>
+
+namespace trivially_relocatable
+{
+  static int live;
+
+  // Owns a heap allocation, and is move bitcopying
+  struct owner
+  {
+    int *p{nullptr};
+    owner() = default;
+    explicit owner(int v)
+        : p(new int(v))
+    {
+      ++live;
+    }
+    owner(owner &&o) noexcept
+        : p(o.p)
+    {
+      o.p = nullptr;
+    }
+    owner(const owner &) = delete;
+    owner &operator=(owner &&o) noexcept
+    {
+      std::swap(p, o.p);
+      return *this;
+    }
+    owner &operator=(const owner &) = delete;
+    ~owner()
+    {
+      if(p != nullptr)
+      {
+        delete p;
+        --live;
+      }
+    }
+  };
+
+  enum class code
+  {
+    bad = 1
+  };
+}  // namespace trivially_relocatable
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct is_move_bitcopying<trivially_relocatable::owner>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+OUTCOME_V2_NAMESPACE_END
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / trivially_relocatable, "Tests that results of trivially relocatable types are trivially relocatable")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using trivially_relocatable::code;
+  using trivially_relocatable::live;
+  using trivially_relocatable::owner;
+  using result_type = result<owner, code, policy::terminate>;
+
+  static_assert(trait::is_trivially_relocatable<result<int, code>>::value, "result<int, code> is not trivially relocatable");
+  static_assert(trait::is_trivially_relocatable<result<void, code>>::value, "result<void, code> is not trivially relocatable");
+  static_assert(trait::is_trivially_relocatable<result_type>::value, "result<owner, code> is not trivially relocatable");
+  static_assert(!trait::is_trivially_relocatable<result<std::string, code>>::value, "result<std::string, code> is trivially relocatable");
+  static_assert(!std::is_trivially_copyable<result_type>::value, "result<owner, code> is trivially copyable");
+
+  {
+    // Swapping every combination of states neither leaks nor double frees
+    result_type a(owner(1)), b(owner(2)), c(code::bad);
+    BOOST_CHECK(live == 2);
+    a.swap(b);
+    BOOST_CHECK(*a.value().p == 2);
+    BOOST_CHECK(*b.value().p == 1);
+    a.swap(c);
+    BOOST_CHECK(a.error() == code::bad);
+    BOOST_CHECK(*c.value().p == 2);
+    a.swap(c);
+    BOOST_CHECK(*a.value().p == 2);
+    BOOST_CHECK(c.error() == code::bad);
+    result_type d(std::move(a));
+    BOOST_CHECK(*d.value().p == 2);
+    a.swap(d);
+    BOOST_CHECK(*a.value().p == 2);
+    BOOST_CHECK(live == 2);
+  }
+  BOOST_CHECK(live == 0);
+  {
+    // A container may relocate its contents using memcpy
+    alignas(result_type) unsigned char from[4 * sizeof(result_type)], to[4 * sizeof(result_type)];
+    auto *src = reinterpret_cast<result_type *>(from);
+    for(int n = 0; n < 4; n++)
+    {
+      if(n % 2 == 0)
+      {
+        new(src + n) result_type(owner(n));
+      }
+      else
+      {
+        new(src + n) result_type(code::bad);
+      }
+    }
+    memcpy(to, from, sizeof(from));
+    auto *dest = reinterpret_cast<result_type *>(to);
+    BOOST_CHECK(live == 2);
+    for(int n = 0; n < 4; n++)
+    {
+      if(n % 2 == 0)
+      {
+        BOOST_CHECK(*dest[n].value().p == n);
+      }
+      else
+      {
+        BOOST_CHECK(dest[n].error() == code::bad);
+      }
+      dest[n].~result_type();
+    }
+    BOOST_CHECK(live == 0);
+  }
+}
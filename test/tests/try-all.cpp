@@ -0,0 +1,141 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+
+namespace try_all
+{
+  namespace outcome = OUTCOME_V2_NAMESPACE;
+
+  static int calls;
+
+  inline outcome::result<int> num(int x)
+  {
+    ++calls;
+    if(x < 0)
+    {
+      return std::error_code(-x, std::generic_category());
+    }
+    return x;
+  }
+  inline outcome::result<std::string> str(int x, int y)
+  {
+    ++calls;
+    if(x < 0)
+    {
+      return std::error_code(-x, std::generic_category());
+    }
+    return std::to_string(x + y);
+  }
+  inline outcome::result<void> check(int x)
+  {
+    ++calls;
+    if(x < 0)
+    {
+      return std::error_code(-x, std::generic_category());
+    }
+    return outcome::success();
+  }
+
+  inline outcome::result<std::string> three(int a, int b, int c)
+  {
+    OUTCOME_TRY_ALL((auto x, num(a)), (auto &&y, str(b, 1)), (check(c)));
+    return std::to_string(x) + ":" + y;
+  }
+  inline outcome::outcome<int> one(int a)
+  {
+    OUTCOME_TRY_ALL((auto x, num(a)));
+    return x;
+  }
+  inline outcome::result<int> eight(int fail)
+  {
+    OUTCOME_TRY_ALL((auto a, num(fail == 1 ? -1 : 1)), (auto b, num(fail == 2 ? -2 : 2)), (auto c, num(fail == 3 ? -3 : 3)), (auto d, num(fail == 4 ? -4 : 4)),
+                    (auto e, num(fail == 5 ? -5 : 5)), (auto f, num(fail == 6 ? -6 : 6)), (auto g, num(fail == 7 ? -7 : 7)), (check(fail == 8 ? -8 : 8)));
+    return a + b + c + d + e + f + g;
+  }
+
+  template <class T, class U> inline outcome::result<T> sum(U x, U y) { return num(static_cast<int>(x + y)); }
+  inline outcome::result<int> commas(int a, int b)
+  {
+    // An (expr) group with a top-level comma needs an extra pair of parentheses, a (var, expr) group does not
+    OUTCOME_TRY_ALL((auto x, sum<int, int>(a, 0)), ((sum<int, int>(b, 0))));
+    return x;
+  }
+
+  inline outcome::result<std::string> first_failure(int a, int b, int c)
+  {
+    auto x = num(a);
+    auto y = str(b, 1);
+    auto z = check(c);
+    if(!outcome::try_operation_has_all_values(x, y, z))
+    {
+      return outcome::try_operation_return_first_failure<outcome::result<std::string>>(std::move(x), std::move(y), std::move(z));
+    }
+    return std::to_string(x.value()) + ":" + y.value();
+  }
+}  // namespace try_all
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / try / all, "Tests that OUTCOME_TRY_ALL checks all of its inputs with one branch, returning the first failure")
+{
+  using namespace try_all;
+  calls = 0;
+  BOOST_CHECK(three(1, 2, 3).value() == "1:3");
+  BOOST_CHECK(calls == 3);
+
+  // Every input is evaluated before any is checked, and the first failure is returned
+  calls = 0;
+  auto r = three(1, -2, -3);
+  BOOST_REQUIRE(r.has_error());
+  BOOST_CHECK(r.error().value() == 2);
+  BOOST_CHECK(calls == 3);
+  BOOST_CHECK(three(-1, -2, -3).error().value() == 1);
+  BOOST_CHECK(three(1, 2, -3).error().value() == 3);
+
+  BOOST_CHECK(one(4).value() == 4);
+  BOOST_CHECK(one(-4).error().value() == 4);
+
+  BOOST_CHECK(eight(0).value() == 28);
+  for(int n = 1; n <= 8; n++)
+  {
+    BOOST_CHECK(eight(n).error().value() == n);
+  }
+
+  // The function form
+  BOOST_CHECK(outcome::try_operation_has_all_values(num(1), str(2, 0), check(3)));
+  BOOST_CHECK(!outcome::try_operation_has_all_values(num(1), str(-2, 0), check(3)));
+  BOOST_CHECK(outcome::try_operation_has_all_values());
+  BOOST_CHECK(first_failure(1, 2, 3).value() == "1:3");
+  BOOST_CHECK(first_failure(1, -2, -3).error().value() == 2);
+  BOOST_CHECK(first_failure(-1, -2, -3).error().value() == 1);
+  BOOST_CHECK(first_failure(1, 2, -3).error().value() == 3);
+  BOOST_CHECK(outcome::try_operation_return_first_failure<outcome::result<int>>(num(-5)).error().value() == 5);
+
+  BOOST_CHECK(commas(1, 2).value() == 1);
+  BOOST_CHECK(commas(-1, -2).error().value() == 1);
+  BOOST_CHECK(commas(1, -2).error().value() == 2);
+}
@@ -0,0 +1,173 @@
+/* Unit testing for outcomes
+(C) 2013-2020 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace try_forward_failure
+{
+  namespace outcome = OUTCOME_V2_NAMESPACE;
+
+  // An error which counts how often it is copied and moved
+  struct counted_error
+  {
+    static int copies, moves;
+
+    int code{0};
+
+    counted_error() = default;
+    explicit counted_error(int c)
+        : code(c)
+    {
+    }
+    counted_error(const counted_error &o)
+        : code(o.code)
+    {
+      ++copies;
+    }
+    counted_error(counted_error &&o) noexcept
+        : code(o.code)
+    {
+      ++moves;
+    }
+    counted_error &operator=(const counted_error &) = default;
+    counted_error &operator=(counted_error &&) = default;
+    ~counted_error() = default;
+
+    static void reset() { copies = moves = 0; }
+  };
+  int counted_error::copies, counted_error::moves;
+
+  template <class T> using result = outcome::result<T, counted_error, outcome::policy::all_narrow>;
+  template <class T> using outcome_ = outcome::outcome<T, counted_error, std::exception_ptr, outcome::policy::all_narrow>;
+
+  inline result<int> fail() { return result<int>(outcome::in_place_type<counted_error>, 5); }
+
+  inline result<std::string> to_result()
+  {
+    OUTCOME_TRY(auto &&v, fail());
+    return std::to_string(v);
+  }
+  inline outcome_<double> to_outcome()
+  {
+    OUTCOME_TRY(auto &&v, fail());
+    return v;
+  }
+  inline result<void> from_lvalue(const result<int> &r)
+  {
+    OUTCOME_TRYV2(const auto &, r);
+    return outcome::success();
+  }
+
+  // A return type which only knows about failure_type
+  struct foreign
+  {
+    int code{0};
+    foreign(outcome::failure_type<counted_error> f)  // NOLINT
+        : code(f.error().code)
+    {
+    }
+  };
+  inline foreign to_foreign()
+  {
+    OUTCOME_TRY(fail());
+    return outcome::failure(counted_error(0));
+  }
+
+  // An input type customised for TRY after Outcome's headers were included
+  struct foreign_input
+  {
+    int code;
+  };
+}  // namespace try_forward_failure
+
+OUTCOME_V2_NAMESPACE_BEGIN
+inline bool try_operation_has_value(const try_forward_failure::foreign_input &v)
+{
+  return v.code == 0;
+}
+inline auto try_operation_return_as(const try_forward_failure::foreign_input &v)
+{
+  return failure(try_forward_failure::counted_error(v.code));
+}
+OUTCOME_V2_NAMESPACE_END
+
+namespace try_forward_failure
+{
+  inline result<int> from_foreign_input(foreign_input v)
+  {
+    OUTCOME_TRYV(v);
+    return 0;
+  }
+}  // namespace try_forward_failure
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / try / forward_failure, "Tests that TRY constructs the returned failure directly from the error of its input")
+{
+  using namespace try_forward_failure;
+  counted_error::reset();
+  auto r1 = to_result();
+  BOOST_REQUIRE(r1.has_error());
+  BOOST_CHECK(r1.error().code == 5);
+  BOOST_CHECK(counted_error::copies == 0);
+#if !defined(_MSC_VER) || defined(__clang__)  // MSVC may not apply NRVO in debug builds
+  BOOST_CHECK(counted_error::moves == 1);
+#endif
+
+  counted_error::reset();
+  auto r2 = to_outcome();
+  BOOST_REQUIRE(r2.has_error());
+  BOOST_CHECK(!r2.has_exception());
+  BOOST_CHECK(r2.error().code == 5);
+  BOOST_CHECK(counted_error::copies == 0);
+#if !defined(_MSC_VER) || defined(__clang__)
+  BOOST_CHECK(counted_error::moves == 1);
+#endif
+
+  // An lvalue input is copied from once, and left as it was
+  result<int> r3(outcome::in_place_type<counted_error>, 6);
+  counted_error::reset();
+  auto r4 = from_lvalue(r3);
+  BOOST_REQUIRE(r4.has_error());
+  BOOST_CHECK(r4.error().code == 6);
+  BOOST_CHECK(r3.error().code == 6);
+  BOOST_CHECK(counted_error::copies == 1);
+
+  // Return types other than results and outcomes still receive a failure_type
+  BOOST_CHECK(to_foreign().code == 5);
+
+  // Customisations for other inputs declared after Outcome are still used
+  BOOST_CHECK(from_foreign_input({7}).error().code == 7);
+
+  // try_operation_return_as() still returns the input's as_failure() when called directly
+  static_assert(std::is_same<decltype(outcome::try_operation_return_as(r3)), outcome::failure_type<counted_error>>::value, "");
+  static_assert(std::is_same<decltype(outcome::try_operation_return_as(std::move(r3))), outcome::failure_type<counted_error>>::value, "");
+  auto f = outcome::try_operation_return_as(r3);
+  BOOST_CHECK(f.error().code == 6);
+  BOOST_CHECK(r3.error().code == 6);
+}